@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+#include "veins_inet/veins_inet.h"
+
+namespace veins {
+
+/**
+ * Number of heap allocations made by the whole process so far.
+ *
+ * Counting is only compiled in if VEINS_INET_COUNT_ALLOCATIONS is defined
+ * (see makefrag), as it replaces the global operator new. Without it, the
+ * count stays at zero and heapAllocationCounting() returns false.
+ */
+VEINS_INET_API uint64_t heapAllocationCount();
+VEINS_INET_API bool heapAllocationCounting();
+
+} // namespace veins
@@ -26,6 +26,7 @@
 //
 
 #include "veins_inet/VeinsInetApplicationBase.h"
+#include "veins_inet/AllocationCounter.h"
 
 #include "inet/common/lifecycle/ModuleOperations.h"
 #include "inet/common/ModuleAccess.h"
@@ -35,6 +36,7 @@
 #include "inet/networklayer/common/L3AddressResolver.h"
 #include "inet/networklayer/common/L3AddressTag_m.h"
 #include "inet/transportlayer/contract/udp/UdpControlInfo_m.h"
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
 
 namespace veins {
 
@@ -42,6 +44,8 @@ using namespace inet;
 
 Define_Module(VeinsInetApplicationBase);
 
+const simsignal_t VeinsInetApplicationBase::allocationsPerPacketSignal = cComponent::registerSignal("allocationsPerPacket");
+
 VeinsInetApplicationBase::VeinsInetApplicationBase()
 {
 }
@@ -56,6 +60,9 @@ void VeinsInetApplicationBase::initialize(int stage)
     ApplicationBase::initialize(stage);
 
     if (stage == INITSTAGE_LOCAL) {
+        signalManager.subscribeCallback(getSimulation()->getSystemModule(), TraCIScenarioManager::traciTimestepBeginSignal, [this](SignalPayload<const simtime_t&> payload) {
+            flushTraciCommands();
+        });
     }
 }
 
@@ -63,7 +70,8 @@ void VeinsInetApplicationBase::handleStartOperation(LifecycleOperation* operatio
 {
     mobility = veins::VeinsInetMobilityAccess().get(getParentModule());
     traci = mobility->getCommandInterface();
-    traciVehicle = mobility->getVehicleCommandInterface();
+    traciVehicle = nullptr;
+    traciCommands.clear();
 
     L3AddressResolver().tryResolve("224.0.0.1", destAddress);
     ASSERT(!destAddress.isUnspecified());
@@ -119,6 +127,12 @@ void VeinsInetApplicationBase::handleCrashOperation(LifecycleOperation* operatio
 void VeinsInetApplicationBase::finish()
 {
     ApplicationBase::finish();
+
+    recordScalar("traciCommandsRequested", traciCommands.getRequested());
+    recordScalar("traciCommandsSent", traciCommands.getSent());
+    recordScalar("traciRoundTripsSaved", traciCommands.getSaved());
+
+    recordScalar("packetsCreated", packetFactory.getCreated());
 }
 
 VeinsInetApplicationBase::~VeinsInetApplicationBase()
@@ -146,22 +160,42 @@ void VeinsInetApplicationBase::handleMessageWhenUp(cMessage* msg)
     socket.processMessage(msg);
 }
 
+void VeinsInetApplicationBase::flushTraciCommands()
+{
+    Enter_Method_Silent();
+    if (operationalState == State::OPERATING && !traciCommands.empty()) {
+        traciCommands.flush(getTraciVehicle());
+    }
+}
+
+TraCICommandInterface::Vehicle* VeinsInetApplicationBase::getTraciVehicle()
+{
+    if (!traciVehicle) traciVehicle = mobility->getVehicleCommandInterface();
+    return traciVehicle;
+}
+
 void VeinsInetApplicationBase::socketDataArrived(UdpSocket* socket, Packet* packet)
 {
-    auto pk = std::shared_ptr<inet::Packet>(packet);
+    auto pk = std::unique_ptr<inet::Packet>(packet);
+    uint64_t allocationsBefore = heapAllocationCount();
 
     // ignore local echoes
     auto srcAddr = pk->getTag<L3AddressInd>()->getSrcAddress();
     if (srcAddr == Ipv4Address::LOOPBACK_ADDRESS) {
         EV_DEBUG << "Ignored local echo: " << pk.get() << endl;
+        recyclePacket(std::move(pk));
         return;
     }
 
     // statistics
     emit(packetReceivedSignal, pk.get());
 
-    // process incoming packet
-    processPacket(pk);
+    // process incoming packet, handing over ownership
+    processPacket(std::move(pk));
+
+    if (heapAllocationCounting()) {
+        emit(allocationsPerPacketSignal, (unsigned long) (heapAllocationCount() - allocationsBefore));
+    }
 }
 
 void VeinsInetApplicationBase::socketErrorArrived(UdpSocket* socket, Indication* indication)
@@ -190,13 +224,29 @@ void VeinsInetApplicationBase::sendPacket(std::unique_ptr<inet::Packet> pk)
     socket.sendTo(pk.release(), destAddress, portNumber);
 }
 
-std::unique_ptr<inet::Packet> VeinsInetApplicationBase::createPacket(std::string name)
+void VeinsInetApplicationBase::forwardPacket(std::unique_ptr<inet::Packet> pk, const char* name)
+{
+    // drop the headers popped on the way up and all indication tags; the
+    // remaining payload chunks are shared, not copied
+    pk->trim();
+    pk->clearTags();
+    pk->setName(name);
+    sendPacket(std::move(pk));
+}
+
+std::unique_ptr<inet::Packet> VeinsInetApplicationBase::createPacket(const char* name)
+{
+    return packetFactory.create(name);
+}
+
+void VeinsInetApplicationBase::recyclePacket(std::unique_ptr<inet::Packet> pk)
 {
-    return std::unique_ptr<Packet>(new Packet(name.c_str()));
+    packetFactory.recycle(std::move(pk));
 }
 
-void VeinsInetApplicationBase::processPacket(std::shared_ptr<inet::Packet> pk)
+void VeinsInetApplicationBase::processPacket(std::unique_ptr<inet::Packet> pk)
 {
+    recyclePacket(std::move(pk));
 }
 
 } // namespace veins
@@ -31,7 +31,10 @@
 #include "inet/applications/base/ApplicationBase.h"
 #include "inet/transportlayer/contract/udp/UdpSocket.h"
 #include "veins_inet/VeinsInetMobility.h"
+#include "veins_inet/VeinsInetPacketFactory.h"
 #include "veins/modules/utility/TimerManager.h"
+#include "veins/modules/utility/SignalManager.h"
+#include "veins_inet/VeinsInetTraCICommandQueue.h"
 
 namespace veins {
 
@@ -39,12 +42,17 @@ class VEINS_INET_API VeinsInetApplicationBase : public inet::ApplicationBase, pu
 protected:
     veins::VeinsInetMobility* mobility;
     veins::TraCICommandInterface* traci;
-    veins::TraCICommandInterface::Vehicle* traciVehicle;
+    veins::TraCICommandInterface::Vehicle* traciVehicle = nullptr; /**< fetched on first use, see getTraciVehicle() */
     veins::TimerManager timerManager{this};
+    veins::VeinsInetTraCICommandQueue traciCommands; // sent at the start of the next TraCI step
+    veins::SignalManager signalManager;
 
     inet::L3Address destAddress;
     const int portNumber = 9001;
     inet::UdpSocket socket;
+    veins::VeinsInetPacketFactory packetFactory;
+
+    static const omnetpp::simsignal_t allocationsPerPacketSignal;
 
 protected:
     virtual int numInitStages() const override;
@@ -58,15 +66,31 @@ protected:
 
     virtual void refreshDisplay() const override;
     virtual void handleMessageWhenUp(inet::cMessage* msg) override;
+    virtual void flushTraciCommands();
+    virtual veins::TraCICommandInterface::Vehicle* getTraciVehicle();
 
     virtual void socketDataArrived(inet::UdpSocket* socket, inet::Packet* packet) override;
     virtual void socketErrorArrived(inet::UdpSocket* socket, inet::Indication* indication) override;
     virtual void socketClosed(inet::UdpSocket* socket) override;
 
-    virtual std::unique_ptr<inet::Packet> createPacket(std::string name);
-    virtual void processPacket(std::shared_ptr<inet::Packet> pk);
+    virtual std::unique_ptr<inet::Packet> createPacket(const char* name);
+    /**
+     * Dispose of a packet the application is done with
+     */
+    virtual void recyclePacket(std::unique_ptr<inet::Packet> pk);
+    /**
+     * Handle a received packet. Ownership passes to the application: it can
+     * keep the packet, hand it on to forwardPacket() or recyclePacket(), or
+     * let it be deleted.
+     */
+    virtual void processPacket(std::unique_ptr<inet::Packet> pk);
     virtual void timestampPayload(inet::Ptr<inet::Chunk> payload);
     virtual void sendPacket(std::unique_ptr<inet::Packet> pk);
+    /**
+     * Send a received packet on as a new one, reusing the packet object and
+     * its (immutable, shared) payload chunks instead of copying them.
+     */
+    virtual void forwardPacket(std::unique_ptr<inet::Packet> pk, const char* name);
 
 public:
     VeinsInetApplicationBase();
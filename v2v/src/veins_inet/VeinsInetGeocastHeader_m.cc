@@ -0,0 +1,693 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.2 from veins_inet/VeinsInetGeocastHeader.msg.
+//
+
+// Disable warnings about unused variables, empty switch stmts, etc:
+#ifdef _MSC_VER
+#  pragma warning(disable:4101)
+#  pragma warning(disable:4065)
+#endif
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wshadow"
+#  pragma clang diagnostic ignored "-Wconversion"
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+#  pragma clang diagnostic ignored "-Wc++98-compat"
+#  pragma clang diagnostic ignored "-Wunreachable-code-break"
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#elif defined(__GNUC__)
+#  pragma GCC diagnostic ignored "-Wshadow"
+#  pragma GCC diagnostic ignored "-Wconversion"
+#  pragma GCC diagnostic ignored "-Wunused-parameter"
+#  pragma GCC diagnostic ignored "-Wold-style-cast"
+#  pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
+#  pragma GCC diagnostic ignored "-Wfloat-conversion"
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <type_traits>
+#include "VeinsInetGeocastHeader_m.h"
+
+namespace omnetpp {
+
+// Template pack/unpack rules. They are declared *after* a1l type-specific pack functions for multiple reasons.
+// They are in the omnetpp namespace, to allow them to be found by argument-dependent lookup via the cCommBuffer argument
+
+// Packing/unpacking an std::vector
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::vector<T,A>& v)
+{
+    int n = v.size();
+    doParsimPacking(buffer, n);
+    for (int i = 0; i < n; i++)
+        doParsimPacking(buffer, v[i]);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::vector<T,A>& v)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    v.resize(n);
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(buffer, v[i]);
+}
+
+// Packing/unpacking an std::list
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::list<T,A>& l)
+{
+    doParsimPacking(buffer, (int)l.size());
+    for (typename std::list<T,A>::const_iterator it = l.begin(); it != l.end(); ++it)
+        doParsimPacking(buffer, (T&)*it);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::list<T,A>& l)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        l.push_back(T());
+        doParsimUnpacking(buffer, l.back());
+    }
+}
+
+// Packing/unpacking an std::set
+template<typename T, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::set<T,Tr,A>& s)
+{
+    doParsimPacking(buffer, (int)s.size());
+    for (typename std::set<T,Tr,A>::const_iterator it = s.begin(); it != s.end(); ++it)
+        doParsimPacking(buffer, *it);
+}
+
+template<typename T, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::set<T,Tr,A>& s)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        T x;
+        doParsimUnpacking(buffer, x);
+        s.insert(x);
+    }
+}
+
+// Packing/unpacking an std::map
+template<typename K, typename V, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::map<K,V,Tr,A>& m)
+{
+    doParsimPacking(buffer, (int)m.size());
+    for (typename std::map<K,V,Tr,A>::const_iterator it = m.begin(); it != m.end(); ++it) {
+        doParsimPacking(buffer, it->first);
+        doParsimPacking(buffer, it->second);
+    }
+}
+
+template<typename K, typename V, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::map<K,V,Tr,A>& m)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        K k; V v;
+        doParsimUnpacking(buffer, k);
+        doParsimUnpacking(buffer, v);
+        m[k] = v;
+    }
+}
+
+// Default pack/unpack function for arrays
+template<typename T>
+void doParsimArrayPacking(omnetpp::cCommBuffer *b, const T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimPacking(b, t[i]);
+}
+
+template<typename T>
+void doParsimArrayUnpacking(omnetpp::cCommBuffer *b, T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(b, t[i]);
+}
+
+// Default rule to prevent compiler from choosing base class' doParsimPacking() function
+template<typename T>
+void doParsimPacking(omnetpp::cCommBuffer *, const T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimPacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+template<typename T>
+void doParsimUnpacking(omnetpp::cCommBuffer *, T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimUnpacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+}  // namespace omnetpp
+
+Register_Class(VeinsInetGeocastHeader)
+
+VeinsInetGeocastHeader::VeinsInetGeocastHeader() : ::inet::FieldsChunk()
+{
+}
+
+VeinsInetGeocastHeader::VeinsInetGeocastHeader(const VeinsInetGeocastHeader& other) : ::inet::FieldsChunk(other)
+{
+    copy(other);
+}
+
+VeinsInetGeocastHeader::~VeinsInetGeocastHeader()
+{
+}
+
+VeinsInetGeocastHeader& VeinsInetGeocastHeader::operator=(const VeinsInetGeocastHeader& other)
+{
+    if (this == &other) return *this;
+    ::inet::FieldsChunk::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void VeinsInetGeocastHeader::copy(const VeinsInetGeocastHeader& other)
+{
+    this->origin = other.origin;
+    this->sequence = other.sequence;
+    this->hopCount = other.hopCount;
+    this->originTime = other.originTime;
+    this->senderX = other.senderX;
+    this->senderY = other.senderY;
+    this->areaX = other.areaX;
+    this->areaY = other.areaY;
+    this->areaRadius = other.areaRadius;
+}
+
+void VeinsInetGeocastHeader::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::inet::FieldsChunk::parsimPack(b);
+    doParsimPacking(b,this->origin);
+    doParsimPacking(b,this->sequence);
+    doParsimPacking(b,this->hopCount);
+    doParsimPacking(b,this->originTime);
+    doParsimPacking(b,this->senderX);
+    doParsimPacking(b,this->senderY);
+    doParsimPacking(b,this->areaX);
+    doParsimPacking(b,this->areaY);
+    doParsimPacking(b,this->areaRadius);
+}
+
+void VeinsInetGeocastHeader::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::inet::FieldsChunk::parsimUnpack(b);
+    doParsimUnpacking(b,this->origin);
+    doParsimUnpacking(b,this->sequence);
+    doParsimUnpacking(b,this->hopCount);
+    doParsimUnpacking(b,this->originTime);
+    doParsimUnpacking(b,this->senderX);
+    doParsimUnpacking(b,this->senderY);
+    doParsimUnpacking(b,this->areaX);
+    doParsimUnpacking(b,this->areaY);
+    doParsimUnpacking(b,this->areaRadius);
+}
+
+int VeinsInetGeocastHeader::getOrigin() const
+{
+    return this->origin;
+}
+
+void VeinsInetGeocastHeader::setOrigin(int origin)
+{
+    handleChange();
+    this->origin = origin;
+}
+
+uint32_t VeinsInetGeocastHeader::getSequence() const
+{
+    return this->sequence;
+}
+
+void VeinsInetGeocastHeader::setSequence(uint32_t sequence)
+{
+    handleChange();
+    this->sequence = sequence;
+}
+
+int VeinsInetGeocastHeader::getHopCount() const
+{
+    return this->hopCount;
+}
+
+void VeinsInetGeocastHeader::setHopCount(int hopCount)
+{
+    handleChange();
+    this->hopCount = hopCount;
+}
+
+omnetpp::simtime_t VeinsInetGeocastHeader::getOriginTime() const
+{
+    return this->originTime;
+}
+
+void VeinsInetGeocastHeader::setOriginTime(omnetpp::simtime_t originTime)
+{
+    handleChange();
+    this->originTime = originTime;
+}
+
+double VeinsInetGeocastHeader::getSenderX() const
+{
+    return this->senderX;
+}
+
+void VeinsInetGeocastHeader::setSenderX(double senderX)
+{
+    handleChange();
+    this->senderX = senderX;
+}
+
+double VeinsInetGeocastHeader::getSenderY() const
+{
+    return this->senderY;
+}
+
+void VeinsInetGeocastHeader::setSenderY(double senderY)
+{
+    handleChange();
+    this->senderY = senderY;
+}
+
+double VeinsInetGeocastHeader::getAreaX() const
+{
+    return this->areaX;
+}
+
+void VeinsInetGeocastHeader::setAreaX(double areaX)
+{
+    handleChange();
+    this->areaX = areaX;
+}
+
+double VeinsInetGeocastHeader::getAreaY() const
+{
+    return this->areaY;
+}
+
+void VeinsInetGeocastHeader::setAreaY(double areaY)
+{
+    handleChange();
+    this->areaY = areaY;
+}
+
+double VeinsInetGeocastHeader::getAreaRadius() const
+{
+    return this->areaRadius;
+}
+
+void VeinsInetGeocastHeader::setAreaRadius(double areaRadius)
+{
+    handleChange();
+    this->areaRadius = areaRadius;
+}
+
+class VeinsInetGeocastHeaderDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_origin,
+        FIELD_sequence,
+        FIELD_hopCount,
+        FIELD_originTime,
+        FIELD_senderX,
+        FIELD_senderY,
+        FIELD_areaX,
+        FIELD_areaY,
+        FIELD_areaRadius,
+    };
+  public:
+    VeinsInetGeocastHeaderDescriptor();
+    virtual ~VeinsInetGeocastHeaderDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(VeinsInetGeocastHeaderDescriptor)
+
+VeinsInetGeocastHeaderDescriptor::VeinsInetGeocastHeaderDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(VeinsInetGeocastHeader)), "inet::FieldsChunk")
+{
+    propertyNames = nullptr;
+}
+
+VeinsInetGeocastHeaderDescriptor::~VeinsInetGeocastHeaderDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool VeinsInetGeocastHeaderDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<VeinsInetGeocastHeader *>(obj)!=nullptr;
+}
+
+const char **VeinsInetGeocastHeaderDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *VeinsInetGeocastHeaderDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int VeinsInetGeocastHeaderDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 9+base->getFieldCount() : 9;
+}
+
+unsigned int VeinsInetGeocastHeaderDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_origin
+        FD_ISEDITABLE,    // FIELD_sequence
+        FD_ISEDITABLE,    // FIELD_hopCount
+        FD_ISEDITABLE,    // FIELD_originTime
+        FD_ISEDITABLE,    // FIELD_senderX
+        FD_ISEDITABLE,    // FIELD_senderY
+        FD_ISEDITABLE,    // FIELD_areaX
+        FD_ISEDITABLE,    // FIELD_areaY
+        FD_ISEDITABLE,    // FIELD_areaRadius
+    };
+    return (field >= 0 && field < 9) ? fieldTypeFlags[field] : 0;
+}
+
+const char *VeinsInetGeocastHeaderDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "origin",
+        "sequence",
+        "hopCount",
+        "originTime",
+        "senderX",
+        "senderY",
+        "areaX",
+        "areaY",
+        "areaRadius",
+    };
+    return (field >= 0 && field < 9) ? fieldNames[field] : nullptr;
+}
+
+int VeinsInetGeocastHeaderDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "origin") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "sequence") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "hopCount") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "originTime") == 0) return baseIndex + 3;
+    if (strcmp(fieldName, "senderX") == 0) return baseIndex + 4;
+    if (strcmp(fieldName, "senderY") == 0) return baseIndex + 5;
+    if (strcmp(fieldName, "areaX") == 0) return baseIndex + 6;
+    if (strcmp(fieldName, "areaY") == 0) return baseIndex + 7;
+    if (strcmp(fieldName, "areaRadius") == 0) return baseIndex + 8;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *VeinsInetGeocastHeaderDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",    // FIELD_origin
+        "uint32_t",    // FIELD_sequence
+        "int",    // FIELD_hopCount
+        "omnetpp::simtime_t",    // FIELD_originTime
+        "double",    // FIELD_senderX
+        "double",    // FIELD_senderY
+        "double",    // FIELD_areaX
+        "double",    // FIELD_areaY
+        "double",    // FIELD_areaRadius
+    };
+    return (field >= 0 && field < 9) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **VeinsInetGeocastHeaderDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *VeinsInetGeocastHeaderDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int VeinsInetGeocastHeaderDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+void VeinsInetGeocastHeaderDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'VeinsInetGeocastHeader'", field);
+    }
+}
+
+const char *VeinsInetGeocastHeaderDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string VeinsInetGeocastHeaderDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        case FIELD_origin: return long2string(pp->getOrigin());
+        case FIELD_sequence: return ulong2string(pp->getSequence());
+        case FIELD_hopCount: return long2string(pp->getHopCount());
+        case FIELD_originTime: return simtime2string(pp->getOriginTime());
+        case FIELD_senderX: return double2string(pp->getSenderX());
+        case FIELD_senderY: return double2string(pp->getSenderY());
+        case FIELD_areaX: return double2string(pp->getAreaX());
+        case FIELD_areaY: return double2string(pp->getAreaY());
+        case FIELD_areaRadius: return double2string(pp->getAreaRadius());
+        default: return "";
+    }
+}
+
+void VeinsInetGeocastHeaderDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        case FIELD_origin: pp->setOrigin(string2long(value)); break;
+        case FIELD_sequence: pp->setSequence(string2ulong(value)); break;
+        case FIELD_hopCount: pp->setHopCount(string2long(value)); break;
+        case FIELD_originTime: pp->setOriginTime(string2simtime(value)); break;
+        case FIELD_senderX: pp->setSenderX(string2double(value)); break;
+        case FIELD_senderY: pp->setSenderY(string2double(value)); break;
+        case FIELD_areaX: pp->setAreaX(string2double(value)); break;
+        case FIELD_areaY: pp->setAreaY(string2double(value)); break;
+        case FIELD_areaRadius: pp->setAreaRadius(string2double(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'VeinsInetGeocastHeader'", field);
+    }
+}
+
+omnetpp::cValue VeinsInetGeocastHeaderDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        case FIELD_origin: return pp->getOrigin();
+        case FIELD_sequence: return (omnetpp::intval_t)(pp->getSequence());
+        case FIELD_hopCount: return pp->getHopCount();
+        case FIELD_originTime: return pp->getOriginTime().dbl();
+        case FIELD_senderX: return pp->getSenderX();
+        case FIELD_senderY: return pp->getSenderY();
+        case FIELD_areaX: return pp->getAreaX();
+        case FIELD_areaY: return pp->getAreaY();
+        case FIELD_areaRadius: return pp->getAreaRadius();
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'VeinsInetGeocastHeader' as cValue -- field index out of range?", field);
+    }
+}
+
+void VeinsInetGeocastHeaderDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        case FIELD_origin: pp->setOrigin(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_sequence: pp->setSequence(omnetpp::checked_int_cast<uint32_t>(value.intValue())); break;
+        case FIELD_hopCount: pp->setHopCount(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_originTime: pp->setOriginTime(value.doubleValue()); break;
+        case FIELD_senderX: pp->setSenderX(value.doubleValue()); break;
+        case FIELD_senderY: pp->setSenderY(value.doubleValue()); break;
+        case FIELD_areaX: pp->setAreaX(value.doubleValue()); break;
+        case FIELD_areaY: pp->setAreaY(value.doubleValue()); break;
+        case FIELD_areaRadius: pp->setAreaRadius(value.doubleValue()); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'VeinsInetGeocastHeader'", field);
+    }
+}
+
+const char *VeinsInetGeocastHeaderDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr VeinsInetGeocastHeaderDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void VeinsInetGeocastHeaderDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    VeinsInetGeocastHeader *pp = omnetpp::fromAnyPtr<VeinsInetGeocastHeader>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'VeinsInetGeocastHeader'", field);
+    }
+}
+
+namespace omnetpp {
+
+}  // namespace omnetpp
+
@@ -0,0 +1,112 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.2 from veins_inet/VeinsInetGeocastHeader.msg.
+//
+
+#ifndef __VEINSINETGEOCASTHEADER_M_H
+#define __VEINSINETGEOCASTHEADER_M_H
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wreserved-id-macro"
+#endif
+#include <omnetpp.h>
+
+// opp_msgtool version check
+#define MSGC_VERSION 0x0602
+#if (MSGC_VERSION!=OMNETPP_VERSION)
+#    error Version mismatch! Probably this file was generated by an earlier version of opp_msgtool: 'make clean' should help.
+#endif
+
+class VeinsInetGeocastHeader;
+#include "inet/common/INETDefs_m.h" // import inet.common.INETDefs
+
+#include "inet/common/packet/chunk/Chunk_m.h" // import inet.common.packet.chunk.Chunk
+
+/**
+ * Class generated from <tt>veins_inet/VeinsInetGeocastHeader.msg:12</tt> by opp_msgtool.
+ * <pre>
+ * //
+ * // Geocast header in front of a VeinsInetSampleMessage. Relays replace it and
+ * // keep the payload chunk as received.
+ * //
+ * class VeinsInetGeocastHeader extends inet::FieldsChunk
+ * {
+ *     int origin;    // Module ID of the originating application
+ *     uint32_t sequence;    // Per-origin sequence number
+ *     int hopCount;
+ *     simtime_t originTime;
+ *     double senderX;    // Position of the last (re)broadcaster
+ *     double senderY;
+ *     double areaX;    // Destination area: circle around (areaX, areaY)
+ *     double areaY;
+ *     double areaRadius;
+ * }
+ * </pre>
+ */
+class VeinsInetGeocastHeader : public ::inet::FieldsChunk
+{
+  protected:
+    int origin = 0;
+    uint32_t sequence = 0;
+    int hopCount = 0;
+    omnetpp::simtime_t originTime = SIMTIME_ZERO;
+    double senderX = 0;
+    double senderY = 0;
+    double areaX = 0;
+    double areaY = 0;
+    double areaRadius = 0;
+
+  private:
+    void copy(const VeinsInetGeocastHeader& other);
+
+  protected:
+    bool operator==(const VeinsInetGeocastHeader&) = delete;
+
+  public:
+    VeinsInetGeocastHeader();
+    VeinsInetGeocastHeader(const VeinsInetGeocastHeader& other);
+    virtual ~VeinsInetGeocastHeader();
+    VeinsInetGeocastHeader& operator=(const VeinsInetGeocastHeader& other);
+    virtual VeinsInetGeocastHeader *dup() const override {return new VeinsInetGeocastHeader(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual int getOrigin() const;
+    virtual void setOrigin(int origin);
+
+    virtual uint32_t getSequence() const;
+    virtual void setSequence(uint32_t sequence);
+
+    virtual int getHopCount() const;
+    virtual void setHopCount(int hopCount);
+
+    virtual omnetpp::simtime_t getOriginTime() const;
+    virtual void setOriginTime(omnetpp::simtime_t originTime);
+
+    virtual double getSenderX() const;
+    virtual void setSenderX(double senderX);
+
+    virtual double getSenderY() const;
+    virtual void setSenderY(double senderY);
+
+    virtual double getAreaX() const;
+    virtual void setAreaX(double areaX);
+
+    virtual double getAreaY() const;
+    virtual void setAreaY(double areaY);
+
+    virtual double getAreaRadius() const;
+    virtual void setAreaRadius(double areaRadius);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const VeinsInetGeocastHeader& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, VeinsInetGeocastHeader& obj) {obj.parsimUnpack(b);}
+
+
+namespace omnetpp {
+
+template<> inline VeinsInetGeocastHeader *fromAnyPtr(any_ptr ptr) { return check_and_cast<VeinsInetGeocastHeader*>(ptr.get<cObject>()); }
+
+}  // namespace omnetpp
+
+#endif // ifndef __VEINSINETGEOCASTHEADER_M_H
+
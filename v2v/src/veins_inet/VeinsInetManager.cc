@@ -35,3 +35,10 @@ void VeinsInetManager::initialize(int stage)
     TraCIScenarioManagerLaunchd::initialize(stage);
     VeinsInetManagerBase::initialize(stage);
 }
+
+void VeinsInetManager::finish()
+{
+    TraCIScenarioManagerLaunchd::finish();
+    VeinsInetManagerBase::recordSpawnStatistics();
+    VeinsInetManagerBase::writeStageProfile();
+}
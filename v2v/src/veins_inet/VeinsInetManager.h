@@ -40,6 +40,7 @@ namespace veins {
  */
 class VEINS_INET_API VeinsInetManager : public VeinsInetManagerBase, public TraCIScenarioManagerLaunchd {
     virtual void initialize(int stage) override;
+    virtual void finish() override;
 };
 
 class VEINS_INET_API VeinsInetManagerAccess {
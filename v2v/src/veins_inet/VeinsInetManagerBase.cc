@@ -51,10 +51,77 @@ void VeinsInetManagerBase::initialize(int stage)
         root->emit(POST_MODEL_CHANGE, notification, NULL);
     });
 #endif
+
+    signalManager.subscribeCallback(this, TraCIScenarioManager::traciModuleAddedSignal, [this](SignalPayload<cObject*> payload) {
+        vehiclesAdded++;
+        initWallTime += std::chrono::duration<double>(WallClock::now() - moduleBuilt).count();
+    });
+
+    signalManager.subscribeCallback(this, TraCIScenarioManager::traciTimestepBeginSignal, [this](SignalPayload<const simtime_t&> payload) {
+        churnAtStepStart = vehiclesAdded + vehiclesRemoved;
+        stepStarted = WallClock::now();
+        V2V_PROFILE_BEGIN("traciStep");
+    });
+
+    signalManager.subscribeCallback(this, TraCIScenarioManager::traciTimestepEndSignal, [this](SignalPayload<const simtime_t&> payload) {
+        V2V_PROFILE_END();
+        double wallTime = std::chrono::duration<double>(WallClock::now() - stepStarted).count();
+        stepWallTime += wallTime;
+        if (vehiclesAdded + vehiclesRemoved != churnAtStepStart) {
+            churnSteps++;
+            churnStepWallTime += wallTime;
+        }
+    });
+
+    // hand the vehicle command handles of leaving nodes back to the registry
+    signalManager.subscribeCallback(this, TraCIScenarioManager::traciModuleRemovedSignal, [this](SignalPayload<cObject*> payload) {
+        cModule* module = dynamic_cast<cModule*>(payload.p);
+        ASSERT(module);
+        vehiclesRemoved++;
+
+        auto mobilityModules = getSubmodulesOfType<VeinsInetMobility>(module);
+        for (auto inetmm : mobilityModules) {
+            inetmm->releaseVehicleCommandInterface();
+        }
+    });
+}
+
+void VeinsInetManagerBase::finish()
+{
+    TraCIScenarioManager::finish();
+    recordSpawnStatistics();
+    writeStageProfile();
+}
+
+void VeinsInetManagerBase::writeStageProfile()
+{
+#ifdef V2V_PROFILE_STAGES
+    std::string profileFile = par("profileFile").stdstringValue();
+    if (profileFile.empty()) return;
+    StageProfiler& profiler = StageProfiler::instance();
+    if (!profiler.writeFolded(profileFile + ".folded") || !profiler.writeSummary(profileFile + ".csv")) {
+        EV_WARN << "Cannot write stage profile " << profileFile << endl;
+    }
+    profiler.clear();
+#endif
+}
+
+void VeinsInetManagerBase::recordSpawnStatistics()
+{
+    recordScalar("vehiclesAdded", vehiclesAdded);
+    recordScalar("vehiclesRemoved", vehiclesRemoved);
+    recordScalar("churnSteps", churnSteps);
+    recordScalar("stepWallTime", stepWallTime, "s");
+    recordScalar("churnStepWallTime", churnStepWallTime, "s");
+    recordScalar("moduleInitWallTime", initWallTime, "s");
+    if (stepWallTime > 0) recordScalar("vehiclesAddedPerSecond", vehiclesAdded / stepWallTime);
+    recordScalar("vehicleHandlesPeak", vehicleRegistry.capacity());
 }
 
 void VeinsInetManagerBase::preInitializeModule(cModule* mod, const std::string& nodeId, const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals)
 {
+    V2V_PROFILE_SCOPE("vehicleSpawn");
+    moduleBuilt = WallClock::now();
     TraCIScenarioManager::preInitializeModule(mod, nodeId, position, road_id, speed, heading, signals);
 
     // pre-initialize VeinsInetMobility
@@ -66,6 +133,7 @@ void VeinsInetManagerBase::preInitializeModule(cModule* mod, const std::string&
 
 void VeinsInetManagerBase::updateModulePosition(cModule* mod, const Coord& p, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals)
 {
+    V2V_PROFILE_SCOPE("mobilityUpdate");
     TraCIScenarioManager::updateModulePosition(mod, p, edge, speed, heading, signals);
 
     // update position in VeinsInetMobility
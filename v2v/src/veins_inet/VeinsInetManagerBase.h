@@ -22,10 +22,14 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "veins_inet/veins_inet.h"
 
 #include "veins/modules/mobility/traci/TraCIScenarioManager.h"
 #include "veins/modules/utility/SignalManager.h"
+#include "veins_inet/VeinsInetStageProfiler.h"
+#include "veins_inet/VeinsInetVehicleRegistry.h"
 
 namespace veins {
 
@@ -43,12 +47,40 @@ public:
     virtual ~VeinsInetManagerBase();
 
     void initialize(int stage) override;
+    void finish() override;
 
     virtual void preInitializeModule(cModule* mod, const std::string& nodeId, const Coord& position, const std::string& road_id, double speed, Heading heading, VehicleSignalSet signals) override;
     virtual void updateModulePosition(cModule* mod, const Coord& p, const std::string& edge, double speed, Heading heading, VehicleSignalSet signals) override;
 
+    VeinsInetVehicleRegistry& getVehicleRegistry()
+    {
+        return vehicleRegistry;
+    }
+
 protected:
     SignalManager signalManager;
+    VeinsInetVehicleRegistry vehicleRegistry;
+
+    // cost of vehicles entering and leaving, for benchmarking high-churn scenarios
+    using WallClock = std::chrono::steady_clock;
+    WallClock::time_point stepStarted;
+    WallClock::time_point moduleBuilt; /**< pre-initialization of the last added module */
+    long vehiclesAdded = 0;
+    long vehiclesRemoved = 0;
+    long churnAtStepStart = 0;
+    long churnSteps = 0; /**< steps that added or removed vehicles */
+    double stepWallTime = 0; /**< s, all TraCI steps */
+    double churnStepWallTime = 0; /**< s, steps that added or removed vehicles */
+    double initWallTime = 0; /**< s, initializing added modules */
+
+protected:
+    void recordSpawnStatistics();
+
+    /**
+     * Writes the stage profile of the run to <profileFile>.folded and .csv
+     * (builds with V2V_PROFILE_STAGES only, see VeinsInetStageProfiler.h).
+     */
+    void writeStageProfile();
 };
 
 class VEINS_INET_API VeinsInetManagerBaseAccess {
@@ -28,6 +28,27 @@ Define_Module(veins::VeinsInetManagerForker);
 
 void VeinsInetManagerForker::initialize(int stage)
 {
+    if (stage == 0) {
+        // warm start: have SUMO save or load its state, see the Forker's commandLine
+        std::string commandLine = par("commandLine").stdstringValue();
+        std::string saveState = par("saveState").stdstringValue();
+        std::string loadState = par("loadState").stdstringValue();
+        if (!saveState.empty()) {
+            commandLine += " --save-state.times " + std::to_string(par("saveStateAt").doubleValue()) + " --save-state.files " + saveState;
+        }
+        if (!loadState.empty()) {
+            commandLine += " --load-state " + loadState;
+        }
+        par("commandLine").setStringValue(commandLine);
+    }
+
     TraCIScenarioManagerForker::initialize(stage);
     VeinsInetManagerBase::initialize(stage);
 }
+
+void VeinsInetManagerForker::finish()
+{
+    TraCIScenarioManagerForker::finish();
+    VeinsInetManagerBase::recordSpawnStatistics();
+    VeinsInetManagerBase::writeStageProfile();
+}
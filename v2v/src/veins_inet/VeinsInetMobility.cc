@@ -26,6 +26,7 @@
 //
 
 #include "veins_inet/VeinsInetMobility.h"
+#include "veins_inet/VeinsInetManagerBase.h"
 
 #include "inet/common/INETMath.h"
 #include "inet/common/Units.h"
@@ -43,7 +44,7 @@ VeinsInetMobility::VeinsInetMobility()
 
 VeinsInetMobility::~VeinsInetMobility()
 {
-    delete vehicleCommandInterface;
+    if (!vehicleRegistry) delete vehicleCommandInterface;
 }
 
 void VeinsInetMobility::preInitialize(std::string external_id, const inet::Coord& position, std::string road_id, double speed, double angle)
@@ -176,8 +177,32 @@ TraCICommandInterface* VeinsInetMobility::getCommandInterface() const
 
 TraCICommandInterface::Vehicle* VeinsInetMobility::getVehicleCommandInterface() const
 {
-    if (!vehicleCommandInterface) vehicleCommandInterface = new TraCICommandInterface::Vehicle(getCommandInterface()->vehicle(getExternalId()));
+    if (!vehicleCommandInterface) {
+        // prefer the manager's shared registry over a handle of our own
+        if (auto veinsInetManager = dynamic_cast<VeinsInetManagerBase*>(getManager())) {
+            vehicleRegistry = &veinsInetManager->getVehicleRegistry();
+            vehicleCommandInterface = vehicleRegistry->acquire(getCommandInterface(), getExternalId());
+        }
+        else {
+            vehicleCommandInterface = new TraCICommandInterface::Vehicle(getCommandInterface()->vehicle(getExternalId()));
+        }
+    }
     return vehicleCommandInterface;
 }
 
+void VeinsInetMobility::releaseVehicleCommandInterface()
+{
+    Enter_Method_Silent();
+    if (!vehicleCommandInterface) return;
+
+    if (vehicleRegistry) {
+        vehicleRegistry->release(external_id);
+        vehicleRegistry = nullptr;
+    }
+    else {
+        delete vehicleCommandInterface;
+    }
+    vehicleCommandInterface = nullptr;
+}
+
 } // namespace veins
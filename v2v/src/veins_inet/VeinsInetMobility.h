@@ -37,6 +37,7 @@ using namespace omnetpp;
 
 #include "veins/modules/mobility/traci/TraCIScenarioManager.h"
 #include "veins/modules/mobility/traci/TraCICommandInterface.h"
+#include "veins_inet/VeinsInetVehicleRegistry.h"
 
 namespace veins {
 
@@ -77,6 +78,9 @@ public:
     virtual TraCICommandInterface* getCommandInterface() const;
     virtual TraCICommandInterface::Vehicle* getVehicleCommandInterface() const;
 
+    /** @brief called by class VeinsInetManager when the vehicle leaves */
+    virtual void releaseVehicleCommandInterface();
+
 protected:
     /** @brief The last velocity that was set by nextPosition(). */
     inet::Coord lastVelocity;
@@ -87,6 +91,7 @@ protected:
     mutable TraCIScenarioManager* manager = nullptr; /**< cached value */
     mutable TraCICommandInterface* commandInterface = nullptr; /**< cached value */
     mutable TraCICommandInterface::Vehicle* vehicleCommandInterface = nullptr; /**< cached value */
+    mutable VeinsInetVehicleRegistry* vehicleRegistry = nullptr; /**< owner of vehicleCommandInterface, if not this */
 
     std::string external_id; /**< identifier used by TraCI server to refer to this node */
 
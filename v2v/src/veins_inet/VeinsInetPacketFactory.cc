@@ -0,0 +1,18 @@
+#include "veins_inet/VeinsInetPacketFactory.h"
+
+namespace veins {
+
+using namespace inet;
+
+std::unique_ptr<inet::Packet> VeinsInetPacketFactory::create(const char* name)
+{
+    created++;
+    return std::unique_ptr<Packet>(new Packet(name));
+}
+
+void VeinsInetPacketFactory::recycle(std::unique_ptr<inet::Packet> pk)
+{
+    pk.reset();
+}
+
+} // namespace veins
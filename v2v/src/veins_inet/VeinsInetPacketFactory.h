@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+
+#include "veins_inet/veins_inet.h"
+
+#include "inet/common/packet/Packet.h"
+
+namespace veins {
+
+/**
+ * Hands out packets for an application.
+ *
+ * Names should be string literals: they are passed straight to the packet,
+ * whose name is interned in the simulation's string pool, so no std::string
+ * is built per send.
+ *
+ * Packets are not pooled: the only ones that come back are received ones,
+ * and a cPacket keeps its message and tree ID, creation time and arrival
+ * data for life, so reusing them would send out packets that look like old
+ * ones. recycle() deletes.
+ */
+class VEINS_INET_API VeinsInetPacketFactory {
+public:
+    VeinsInetPacketFactory() = default;
+    VeinsInetPacketFactory(const VeinsInetPacketFactory&) = delete;
+    VeinsInetPacketFactory& operator=(const VeinsInetPacketFactory&) = delete;
+
+    std::unique_ptr<inet::Packet> create(const char* name);
+    void recycle(std::unique_ptr<inet::Packet> pk);
+
+    long getCreated() const { return created; }
+
+protected:
+    long created = 0;
+};
+
+/**
+ * Pre-built chunk whose constant fields are filled in once; instantiate()
+ * copies it, so only the per-send fields need to be set afterwards.
+ */
+template <typename T>
+class ChunkPrototype {
+public:
+    ChunkPrototype()
+        : prototype(inet::makeShared<T>())
+    {
+    }
+
+    T* operator->()
+    {
+        return prototype.get();
+    }
+
+    inet::Ptr<T> instantiate() const
+    {
+        return inet::staticPtrCast<T>(prototype->dupShared());
+    }
+
+protected:
+    inet::Ptr<T> prototype;
+};
+
+} // namespace veins
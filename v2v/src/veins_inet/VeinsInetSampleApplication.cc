@@ -22,6 +22,8 @@
 
 #include "veins_inet/VeinsInetSampleApplication.h"
 
+#include <algorithm>
+
 #include "inet/common/ModuleAccess.h"
 #include "inet/common/packet/Packet.h"
 #include "inet/common/TagBase_m.h"
@@ -36,10 +38,95 @@ using namespace inet;
 
 Define_Module(VeinsInetSampleApplication);
 
+const simsignal_t VeinsInetSampleApplication::disseminationLatencySignal = cComponent::registerSignal("disseminationLatency");
+const simsignal_t VeinsInetSampleApplication::geocastHopCountSignal = cComponent::registerSignal("geocastHopCount");
+
+namespace {
+
+// Wire size of VeinsInetGeocastHeader: origin, sequence and hopCount,
+// originTime as a raw simtime, sender and area positions, areaRadius
+const B geocastHeaderLength = B(3 * sizeof(int32_t) + sizeof(int64_t) + 6 * sizeof(double));
+
+uint64_t messageKey(int origin, uint32_t sequence)
+{
+    return (uint64_t(uint32_t(origin)) << 32) | sequence;
+}
+
+// Vehicles finish whenever they leave the scenario, so coverage is only known
+// once the network has finished
+class RunFinishListener : public cISimulationLifecycleListener {
+public:
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details) override
+    {
+        if (eventType == LF_POST_NETWORK_FINISH) {
+            VeinsInetSampleApplication::finishRun(getSimulation()->getSystemModule());
+        }
+    }
+    void listenerRemoved() override {} // static, never deleted
+};
+
+RunFinishListener runFinishListener;
+
+} // namespace
+
+bool VeinsInetSampleApplication::runListenerAdded = false;
+long VeinsInetSampleApplication::runNodes = 0;
+long VeinsInetSampleApplication::runNodesReached = 0;
+
 VeinsInetSampleApplication::VeinsInetSampleApplication()
 {
 }
 
+void VeinsInetSampleApplication::initialize(int stage)
+{
+    VeinsInetApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        geocastRadius = par("geocastRadius");
+        maxHops = par("maxHops");
+        communicationRange = par("communicationRange");
+        maxContentionDelay = par("maxContentionDelay");
+        contentionJitter = par("contentionJitter");
+        suppressionThreshold = par("suppressionThreshold");
+        seenCacheSize = par("seenCacheSize").intValue();
+        if (seenCacheSize < 1) throw cRuntimeError("seenCacheSize must be positive");
+
+        accidentPrototype->setChunkLength(B(100));
+        geocastPrototype->setChunkLength(geocastHeaderLength);
+
+        if (!runListenerAdded) {
+            getEnvir()->addLifecycleListener(&runFinishListener);
+            runListenerAdded = true;
+        }
+    }
+}
+
+void VeinsInetSampleApplication::finish()
+{
+    VeinsInetApplicationBase::finish();
+
+    runNodes++;
+    if (geocastsReceived > 0) runNodesReached++;
+
+    recordScalar("geocastsOriginated", geocastsOriginated);
+    recordScalar("geocastsReceived", geocastsReceived);
+    recordScalar("duplicatesReceived", duplicatesReceived);
+    recordScalar("rebroadcasts", rebroadcasts);
+    recordScalar("rebroadcastsSuppressed", rebroadcastsSuppressed);
+}
+
+void VeinsInetSampleApplication::finishRun(cComponent* target)
+{
+    if (runNodes == 0) return; // a run without this application
+
+    // coverage: share of nodes with geocastsReceived > 0
+    target->recordScalar("geocastNodes", runNodes);
+    target->recordScalar("geocastNodesReached", runNodesReached);
+    target->recordScalar("geocastCoverage", double(runNodesReached) / runNodes);
+    runNodes = 0;
+    runNodesReached = 0;
+}
+
 bool VeinsInetSampleApplication::startApplication()
 {
     // host[0] should stop at t=20s
@@ -47,20 +134,17 @@ bool VeinsInetSampleApplication::startApplication()
         auto callback = [this]() {
             getParentModule()->getDisplayString().setTagArg("i", 1, "red");
 
-            traciVehicle->setSpeed(0);
+            traciCommands.setSpeed(0);
 
-            auto payload = makeShared<VeinsInetSampleMessage>();
-            payload->setChunkLength(B(100));
-            payload->setRoadId(traciVehicle->getRoadId().c_str());
+            auto payload = accidentPrototype.instantiate();
+            payload->setRoadId(getTraciVehicle()->getRoadId().c_str());
             timestampPayload(payload);
 
-            auto packet = createPacket("accident");
-            packet->insertAtBack(payload);
-            sendPacket(std::move(packet));
+            originateGeocast(payload);
 
             // host should continue after 30s
             auto callback = [this]() {
-                traciVehicle->setSpeed(-1);
+                traciCommands.setSpeed(-1);
             };
             timerManager.create(veins::TimerSpecification(callback).oneshotIn(SimTime(30, SIMTIME_S)));
         };
@@ -72,6 +156,12 @@ bool VeinsInetSampleApplication::startApplication()
 
 bool VeinsInetSampleApplication::stopApplication()
 {
+    for (auto& it : seen) {
+        forget(it.second);
+    }
+    seen.clear();
+    seenOrder.clear();
+
     return true;
 }
 
@@ -79,21 +169,127 @@ VeinsInetSampleApplication::~VeinsInetSampleApplication()
 {
 }
 
-void VeinsInetSampleApplication::processPacket(std::shared_ptr<inet::Packet> pk)
+void VeinsInetSampleApplication::originateGeocast(inet::Ptr<VeinsInetSampleMessage> payload)
+{
+    Coord pos = mobility->getCurrentPosition();
+
+    auto header = geocastPrototype.instantiate();
+    header->setOrigin(getId());
+    header->setSequence(nextSequence++);
+    header->setOriginTime(simTime());
+    header->setSenderX(pos.x);
+    header->setSenderY(pos.y);
+    header->setAreaX(pos.x);
+    header->setAreaY(pos.y);
+    header->setAreaRadius(geocastRadius);
+
+    // relays of our own message count as duplicates
+    remember(messageKey(header->getOrigin(), header->getSequence())).copies = 1;
+
+    auto packet = createPacket("accident");
+    packet->insertAtBack(header);
+    packet->insertAtBack(payload);
+    sendPacket(std::move(packet));
+
+    geocastsOriginated++;
+}
+
+void VeinsInetSampleApplication::processPacket(std::unique_ptr<inet::Packet> pk)
 {
+    auto header = pk->popAtFront<VeinsInetGeocastHeader>();
+    uint64_t key = messageKey(header->getOrigin(), header->getSequence());
+
+    auto it = seen.find(key);
+    if (it != seen.end()) {
+        // counter-based suppression: enough neighbours have covered the area already
+        SeenMessage& entry = it->second;
+        entry.copies++;
+        duplicatesReceived++;
+        if (entry.contending && entry.copies >= suppressionThreshold) {
+            EV_DEBUG << "Suppressing rebroadcast after " << entry.copies << " copies" << endl;
+            forget(entry);
+            rebroadcastsSuppressed++;
+        }
+        recyclePacket(std::move(pk));
+        return;
+    }
+
     auto payload = pk->peekAtFront<VeinsInetSampleMessage>();
 
     EV_INFO << "Received packet: " << payload << endl;
 
+    geocastsReceived++;
+    emit(disseminationLatencySignal, simTime() - header->getOriginTime());
+    emit(geocastHopCountSignal, header->getHopCount());
+
     getParentModule()->getDisplayString().setTagArg("i", 1, "green");
 
-    traciVehicle->changeRoute(payload->getRoadId(), 999.9);
+    traciCommands.changeRoute(payload->getRoadId(), 999.9);
 
-    if (haveForwarded) return;
+    SeenMessage& entry = remember(key);
+    entry.copies = 1;
 
-    auto packet = createPacket("relay");
-    packet->insertAtBack(payload);
-    sendPacket(std::move(packet));
+    Coord pos = mobility->getCurrentPosition();
+    bool inArea = pos.distance(Coord(header->getAreaX(), header->getAreaY())) <= header->getAreaRadius();
+    if (!inArea || header->getHopCount() + 1 >= maxHops) {
+        recyclePacket(std::move(pk));
+        return;
+    }
+
+    // distance-based contention: the farther from the last sender, the
+    // sooner a node rebroadcasts, so the outermost nodes carry the message on
+    double distance = pos.distance(Coord(header->getSenderX(), header->getSenderY()));
+    double progress = std::min(distance, communicationRange) / communicationRange;
+    simtime_t delay = maxContentionDelay * (1 - progress) + uniform(0, contentionJitter.dbl());
 
-    haveForwarded = true;
+    entry.contending = true;
+    entry.pending = std::move(pk);
+    entry.header = header;
+    entry.contention = timerManager.create(veins::TimerSpecification([this, key]() { rebroadcast(key); }).oneshotIn(delay));
+}
+
+void VeinsInetSampleApplication::rebroadcast(uint64_t key)
+{
+    auto it = seen.find(key);
+    if (it == seen.end() || !it->second.contending) return;
+
+    SeenMessage& entry = it->second;
+    entry.contending = false;
+
+    Coord pos = mobility->getCurrentPosition();
+    auto header = staticPtrCast<VeinsInetGeocastHeader>(entry.header->dupShared());
+    header->setHopCount(header->getHopCount() + 1);
+    header->setSenderX(pos.x);
+    header->setSenderY(pos.y);
+    entry.header = nullptr;
+
+    // replace the header, keep the payload chunk
+    auto pk = std::move(entry.pending);
+    pk->trim();
+    pk->insertAtFront(header);
+    forwardPacket(std::move(pk), "relay");
+
+    rebroadcasts++;
+}
+
+VeinsInetSampleApplication::SeenMessage& VeinsInetSampleApplication::remember(uint64_t key)
+{
+    if (seen.size() >= seenCacheSize) {
+        auto oldest = seen.find(seenOrder.front());
+        forget(oldest->second);
+        seen.erase(oldest);
+        seenOrder.pop_front();
+    }
+    seenOrder.push_back(key);
+    return seen[key];
+}
+
+void VeinsInetSampleApplication::forget(SeenMessage& entry)
+{
+    if (entry.contending) {
+        timerManager.cancel(entry.contention);
+        entry.contending = false;
+    }
+    if (entry.pending) recyclePacket(std::move(entry.pending));
+    entry.header = nullptr;
 }
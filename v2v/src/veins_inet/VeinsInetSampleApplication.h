@@ -22,20 +22,75 @@
 
 #pragma once
 
+#include <deque>
+#include <unordered_map>
+
 #include "veins_inet/veins_inet.h"
 
 #include "veins_inet/VeinsInetApplicationBase.h"
+#include "veins_inet/VeinsInetGeocastHeader_m.h"
+#include "veins_inet/VeinsInetSampleMessage_m.h"
 
 class VEINS_INET_API VeinsInetSampleApplication : public veins::VeinsInetApplicationBase {
 protected:
-    bool haveForwarded = false;
+    /**
+     * What a node remembers about a geocast message, keyed by (origin, sequence)
+     */
+    struct SeenMessage {
+        int copies = 0; // receptions, including the first one
+        bool contending = false; // rebroadcast scheduled and not yet suppressed
+        omnetpp::cMessage* contention = nullptr; // timer handle
+        std::unique_ptr<inet::Packet> pending; // first copy, sent on when contention ends
+        inet::Ptr<const VeinsInetGeocastHeader> header;
+    };
+
+protected:
+    veins::ChunkPrototype<VeinsInetSampleMessage> accidentPrototype;
+    veins::ChunkPrototype<VeinsInetGeocastHeader> geocastPrototype;
+
+    double geocastRadius;
+    int maxHops;
+    double communicationRange;
+    omnetpp::simtime_t maxContentionDelay;
+    omnetpp::simtime_t contentionJitter;
+    int suppressionThreshold;
+    size_t seenCacheSize;
+
+    uint32_t nextSequence = 0;
+    std::unordered_map<uint64_t, SeenMessage> seen;
+    std::deque<uint64_t> seenOrder; // insertion order, for evicting the oldest entry
+
+    long geocastsOriginated = 0;
+    long geocastsReceived = 0;
+    long duplicatesReceived = 0;
+    long rebroadcasts = 0;
+    long rebroadcastsSuppressed = 0;
+
+    static bool runListenerAdded; // finishRun hooked into the simulation lifecycle
+    static long runNodes; // applications finished in the current run
+    static long runNodesReached; // of which received at least one geocast
+
+    static const omnetpp::simsignal_t disseminationLatencySignal;
+    static const omnetpp::simsignal_t geocastHopCountSignal;
 
 protected:
+    virtual void initialize(int stage) override;
+    virtual void finish() override;
     virtual bool startApplication() override;
     virtual bool stopApplication() override;
-    virtual void processPacket(std::shared_ptr<inet::Packet> pk) override;
+    virtual void processPacket(std::unique_ptr<inet::Packet> pk) override;
+
+    virtual void originateGeocast(inet::Ptr<VeinsInetSampleMessage> payload);
+    virtual void rebroadcast(uint64_t key);
+    SeenMessage& remember(uint64_t key);
+    void forget(SeenMessage& entry);
 
 public:
+    /**
+     * Records the delivery coverage of the run on target, once the network has finished
+     */
+    static void finishRun(omnetpp::cComponent* target);
+
     VeinsInetSampleApplication();
     ~VeinsInetSampleApplication();
 };
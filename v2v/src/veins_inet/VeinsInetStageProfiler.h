@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * Stage profiling hooks for veins_inet.
+ *
+ * With V2V_PROFILE_STAGES defined (see makefrag), this pulls in the
+ * StageProfiler of the V2V application sources, which must then be installed
+ * into and built with Veins, so that the manager's stages nest with the
+ * application's in one profile. Without it, veins_inet builds against a stock
+ * Veins and the V2V_PROFILE_* macros expand to nothing.
+ */
+
+#ifdef V2V_PROFILE_STAGES
+#include "veins/modules/application/traci/StageProfiler.h"
+#else
+#define V2V_PROFILE_SCOPE(name) ((void) 0)
+#define V2V_PROFILE_BEGIN(name) ((void) 0)
+#define V2V_PROFILE_END() ((void) 0)
+#endif
@@ -0,0 +1,72 @@
+#include "veins_inet/VeinsInetTraCICommandQueue.h"
+
+#include <algorithm>
+
+namespace veins {
+
+namespace {
+
+using RouteChanges = std::vector<std::pair<std::string, double>>;
+
+RouteChanges::iterator findRoad(RouteChanges& changes, const std::string& roadId)
+{
+    return std::find_if(changes.begin(), changes.end(), [&roadId](const std::pair<std::string, double>& change) { return change.first == roadId; });
+}
+
+} // namespace
+
+void VeinsInetTraCICommandQueue::setSpeed(double speed)
+{
+    requested++;
+    speedPending = !speedSent || speed != sentSpeed;
+    pendingSpeed = speed;
+}
+
+void VeinsInetTraCICommandQueue::changeRoute(const std::string& roadId, double travelTime)
+{
+    requested++;
+    auto sentChange = findRoad(sentRouteChanges, roadId);
+    bool alreadySent = sentChange != sentRouteChanges.end() && sentChange->second == travelTime;
+
+    auto pending = findRoad(routeChanges, roadId);
+    if (pending != routeChanges.end()) routeChanges.erase(pending);
+    if (!alreadySent) routeChanges.emplace_back(roadId, travelTime);
+}
+
+int VeinsInetTraCICommandQueue::flush(TraCICommandInterface::Vehicle* vehicle)
+{
+    if (!vehicle || empty()) return 0;
+
+    int roundTrips = 0;
+    if (speedPending) {
+        vehicle->setSpeed(pendingSpeed);
+        speedPending = false;
+        speedSent = true;
+        sentSpeed = pendingSpeed;
+        roundTrips++;
+    }
+    for (const auto& change : routeChanges) {
+        vehicle->changeRoute(change.first, change.second);
+        auto sentChange = findRoad(sentRouteChanges, change.first);
+        if (sentChange == sentRouteChanges.end()) {
+            sentRouteChanges.push_back(change);
+        }
+        else {
+            sentChange->second = change.second;
+        }
+        roundTrips++;
+    }
+    routeChanges.clear();
+    sent += roundTrips;
+    return roundTrips;
+}
+
+void VeinsInetTraCICommandQueue::clear()
+{
+    speedPending = false;
+    speedSent = false;
+    routeChanges.clear();
+    sentRouteChanges.clear();
+}
+
+} // namespace veins
@@ -0,0 +1,88 @@
+#include "veins_inet/VeinsInetVehicleRegistry.h"
+
+#include <functional>
+#include <utility>
+
+namespace veins {
+
+TraCICommandInterface::Vehicle* VeinsInetVehicleRegistry::acquire(TraCICommandInterface* traci, const std::string& externalId)
+{
+    size_t index = find(externalId);
+    if (index != noSlot) return &*slots[table[index].slot];
+
+    size_t slot;
+    if (freeSlots.empty()) {
+        slot = slots.size();
+        slots.emplace_back();
+    }
+    else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    slots[slot].emplace(traci->vehicle(externalId));
+
+    if (2 * (used + 1) > table.size()) grow();
+    size_t mask = table.size() - 1;
+    index = home(externalId);
+    while (table[index].slot != noSlot) index = (index + 1) & mask;
+    table[index].externalId.assign(externalId); // reuses the entry's buffer
+    table[index].slot = slot;
+    used++;
+    return &*slots[slot];
+}
+
+void VeinsInetVehicleRegistry::release(const std::string& externalId)
+{
+    size_t index = find(externalId);
+    if (index == noSlot) return;
+
+    slots[table[index].slot].reset();
+    freeSlots.push_back(table[index].slot);
+    table[index].slot = noSlot;
+    used--;
+
+    // shift later entries of the probe sequence back into the gap, so lookups
+    // never need tombstones; swapping keeps every entry's string buffer
+    size_t mask = table.size() - 1;
+    size_t gap = index;
+    for (size_t next = (gap + 1) & mask; table[next].slot != noSlot; next = (next + 1) & mask) {
+        size_t wanted = home(table[next].externalId);
+        // move the entry unless its home lies cyclically in (gap, next]
+        bool reachable = gap <= next ? (gap < wanted && wanted <= next) : (gap < wanted || wanted <= next);
+        if (reachable) continue;
+        std::swap(table[gap].externalId, table[next].externalId);
+        table[gap].slot = table[next].slot;
+        table[next].slot = noSlot;
+        gap = next;
+    }
+}
+
+size_t VeinsInetVehicleRegistry::find(const std::string& externalId) const
+{
+    if (used == 0) return noSlot;
+    size_t mask = table.size() - 1;
+    for (size_t index = home(externalId); table[index].slot != noSlot; index = (index + 1) & mask) {
+        if (table[index].externalId == externalId) return index;
+    }
+    return noSlot;
+}
+
+size_t VeinsInetVehicleRegistry::home(const std::string& externalId) const
+{
+    return std::hash<std::string>()(externalId) & (table.size() - 1);
+}
+
+void VeinsInetVehicleRegistry::grow()
+{
+    std::vector<Entry> old(table.empty() ? 16 : 2 * table.size());
+    std::swap(table, old);
+    size_t mask = table.size() - 1;
+    for (Entry& entry : old) {
+        if (entry.slot == noSlot) continue;
+        size_t index = home(entry.externalId);
+        while (table[index].slot != noSlot) index = (index + 1) & mask;
+        table[index] = std::move(entry);
+    }
+}
+
+} // namespace veins
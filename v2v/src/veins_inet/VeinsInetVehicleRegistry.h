@@ -0,0 +1,63 @@
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "veins_inet/veins_inet.h"
+
+#include "veins/modules/mobility/traci/TraCICommandInterface.h"
+
+namespace veins {
+
+/**
+ * Vehicle command handles of all nodes, owned by the manager.
+ *
+ * Handles live in a slot arena and are looked up by TraCI id in an open
+ * addressing table (linear probing, backward shift on removal). Both only
+ * grow with the peak number of vehicles present at once: the slot of a
+ * removed vehicle is reused by the next one, and so are the string buffers
+ * of the table entries, so once that peak has been reached the registry
+ * allocates nothing for nodes coming and going. The Vehicle handle keeps its
+ * own copy of the id, which only allocates for ids too long for the inline
+ * string buffer.
+ */
+class VEINS_INET_API VeinsInetVehicleRegistry {
+public:
+    /** @brief handle for the vehicle, created on first use */
+    TraCICommandInterface::Vehicle* acquire(TraCICommandInterface* traci, const std::string& externalId);
+
+    /** @brief frees the handle of a vehicle that left the simulation */
+    void release(const std::string& externalId);
+
+    size_t size() const
+    {
+        return used;
+    }
+
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+protected:
+    static constexpr size_t noSlot = size_t(-1);
+
+    struct Entry {
+        std::string externalId;
+        size_t slot = noSlot; /**< noSlot if the entry is empty */
+    };
+
+    /** @brief table index of the vehicle, or noSlot */
+    size_t find(const std::string& externalId) const;
+    size_t home(const std::string& externalId) const;
+    void grow();
+
+    std::deque<std::optional<TraCICommandInterface::Vehicle>> slots; /**< stable addresses */
+    std::vector<size_t> freeSlots;
+    std::vector<Entry> table; /**< power of two entries, at most half of them used */
+    size_t used = 0;
+};
+
+} // namespace veins
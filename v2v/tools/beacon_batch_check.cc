@@ -0,0 +1,139 @@
+//
+// Randomized check of validateBatch (SIMD) against validateBatchScalar and
+// SecurityDetector::validateMessageContent, without OMNeT++, Veins or SUMO.
+//
+// Batches of random size mix plausible beacons with NaN and infinite
+// positions, speeds around and far above the limit, and future and stale
+// timestamps. The SIMD and scalar paths must agree exactly; against
+// validateMessageContent only a speed within rounding of the limit may differ
+// (see BeaconBatch.h).
+//
+//   beacon_batch_check                      default seed and batch count
+//   beacon_batch_check --batches=N --seed=S
+//
+// Exits nonzero on the first mismatch. Run by "make check".
+//
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "veins/modules/application/traci/BeaconBatch.h"
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+using namespace veins;
+
+namespace {
+
+double pick(std::mt19937& rng, double plausible, double limit)
+{
+    switch (rng() % 8) {
+    case 0:
+        return std::numeric_limits<double>::quiet_NaN();
+    case 1:
+        return rng() % 2 ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+    case 2:
+        return limit;
+    case 3:
+        return std::nextafter(limit, 2 * limit);
+    default:
+        return std::uniform_real_distribution<double>(-plausible, plausible)(rng);
+    }
+}
+
+ReceptionEvent randomEvent(std::mt19937& rng, const DetectorParams& params)
+{
+    ReceptionEvent ev;
+    ev.time = std::uniform_real_distribution<double>(0, 1000)(rng);
+    ev.posX = pick(rng, 5000, 1e300);
+    ev.posY = pick(rng, 5000, -1e300);
+    ev.speedX = pick(rng, 2 * params.maxReasonableSpeed, params.maxReasonableSpeed);
+    ev.speedY = rng() % 2 ? 0.0 : pick(rng, params.maxReasonableSpeed, params.maxReasonableSpeed);
+    switch (rng() % 4) {
+    case 0:
+        ev.timestamp = ev.time + std::uniform_real_distribution<double>(0, 1)(rng);   // Future
+        break;
+    case 1:
+        ev.timestamp = ev.time - params.maxMessageAge - std::uniform_real_distribution<double>(-1e-9, 1)(rng);
+        break;
+    default:
+        ev.timestamp = ev.time - std::uniform_real_distribution<double>(0, params.maxMessageAge)(rng);
+    }
+    return ev;
+}
+
+bool nearSpeedLimit(const ReceptionEvent& ev, const DetectorParams& params)
+{
+    double speed = std::sqrt(ev.speedX * ev.speedX + ev.speedY * ev.speedY);
+    return std::fabs(speed - params.maxReasonableSpeed) <= 1e-12 * params.maxReasonableSpeed;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long batches = 20000;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--batches=", 10) == 0) {
+            batches = std::atol(argv[i] + 10);
+        }
+        else if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = unsigned(std::atol(argv[i] + 7));
+        }
+        else {
+            std::fprintf(stderr, "usage: beacon_batch_check [--batches=N] [--seed=S]\n");
+            return 2;
+        }
+    }
+
+    std::mt19937 rng(seed);
+    DetectorParams params;
+    SecurityDetector detector(params);
+    BeaconBatch batch;
+    std::vector<ReceptionEvent> events;
+    std::vector<uint8_t> simd, scalar;
+    long beacons = 0;
+    long nearLimit = 0;
+
+    for (long b = 0; b < batches; b++) {
+        events.resize(rng() % 101);
+        for (ReceptionEvent& ev : events) {
+            ev = randomEvent(rng, params);
+        }
+        batch.assign(events.data(), events.size());
+        simd.assign(events.size() + 1, 0xff);
+        scalar.assign(events.size() + 1, 0xff);
+
+        size_t validSimd = validateBatch(batch, params, simd.data());
+        size_t validScalar = validateBatchScalar(batch, params, scalar.data());
+        if (validSimd != validScalar || simd != scalar) {
+            std::fprintf(stderr, "beacon_batch_check: batch %ld of %zu beacons: SIMD and scalar results differ\n", b, events.size());
+            return 1;
+        }
+        for (size_t i = 0; i < events.size(); i++) {
+            ContentCheck expected = detector.validateMessageContent(events[i]);
+            if (simd[i] == uint8_t(expected)) {
+                continue;
+            }
+            bool speedOnly = (expected == ContentCheck::UnreasonableSpeed || simd[i] == uint8_t(ContentCheck::UnreasonableSpeed));
+            if (!speedOnly || !nearSpeedLimit(events[i], params)) {
+                std::fprintf(stderr, "beacon_batch_check: batch %ld beacon %zu: %s, validateMessageContent says %s\n", b, i,
+                        contentCheckName(ContentCheck(simd[i])), contentCheckName(expected));
+                return 1;
+            }
+            nearLimit++;
+        }
+        if (simd[events.size()] != 0xff) {
+            std::fprintf(stderr, "beacon_batch_check: batch %ld: wrote past the end of checks\n", b);
+            return 1;
+        }
+        beacons += events.size();
+    }
+    std::printf("beacon_batch_check: %ld batches, %ld beacons ok (%ld within rounding of the speed limit)\n", batches, beacons, nearLimit);
+    return 0;
+}
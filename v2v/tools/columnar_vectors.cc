@@ -0,0 +1,335 @@
+//
+// Reader for the columnar output vector files of ColumnarOutputVectorManager.
+//
+//   columnar_vectors list FILE.vecc
+//   columnar_vectors dump FILE.vecc MODULE NAME     CSV of one vector
+//   columnar_vectors convert IN.vec OUT.vecc        convert a text .vec file
+//   columnar_vectors bench FILE.vecc [FILE.vec]     load time of all vectors
+//
+// Record columnar vectors with:
+//   outputvectormanager-class = "veins::ColumnarOutputVectorManager"
+// Existing text results can be converted to compare load times, e.g.
+//   columnar_vectors convert results/V2VWorking-#0.vec /tmp/w.vecc
+//   columnar_vectors bench /tmp/w.vecc results/V2VWorking-#0.vec
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "veins/modules/application/traci/ColumnarVectorFile.h"
+
+using namespace veins;
+
+namespace {
+
+// Resolution used for converted text files, OMNeT++'s default
+const int textTimeScaleExp = -12;
+
+struct TextVector {
+    std::string module;
+    std::string name;
+    VectorAttributes attributes;
+    ColumnarVectorData data;
+    std::vector<int64_t> rawTimes;
+};
+
+void usage()
+{
+    std::fprintf(stderr,
+            "usage: columnar_vectors list FILE.vecc\n"
+            "       columnar_vectors dump FILE.vecc MODULE NAME\n"
+            "       columnar_vectors convert IN.vec OUT.vecc\n"
+            "       columnar_vectors bench [--repeat=N] FILE.vecc [FILE.vec]\n");
+}
+
+// Splits a .vec line into whitespace separated tokens, unquoting "..." tokens
+std::vector<std::string> tokenize(const char* line)
+{
+    std::vector<std::string> tokens;
+    const char* p = line;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        }
+        if (!*p) {
+            break;
+        }
+        std::string token;
+        if (*p == '"') {
+            for (p++; *p && *p != '"'; p++) {
+                if (*p == '\\' && p[1]) {
+                    p++;
+                }
+                token += *p;
+            }
+            if (*p == '"') {
+                p++;
+            }
+        } else {
+            while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+                token += *p++;
+            }
+        }
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+// Exact decimal seconds -> raw simulation time at textTimeScaleExp
+int64_t parseRawTime(const char* text)
+{
+    bool negative = *text == '-';
+    if (negative) {
+        text++;
+    }
+    int64_t raw = 0;
+    for (; *text >= '0' && *text <= '9'; text++) {
+        raw = raw * 10 + (*text - '0');
+    }
+    int digits = 0;
+    if (*text == '.') {
+        for (text++; *text >= '0' && *text <= '9' && digits < -textTimeScaleExp; text++, digits++) {
+            raw = raw * 10 + (*text - '0');
+        }
+    }
+    for (; digits < -textTimeScaleExp; digits++) {
+        raw *= 10;
+    }
+    return negative ? -raw : raw;
+}
+
+// Parses the vector declarations and ETV data lines of a text .vec file
+bool readTextVectors(const std::string& fileName, std::vector<TextVector>& vectors, std::string& error)
+{
+    std::FILE* file = std::fopen(fileName.c_str(), "r");
+    if (!file) {
+        error = "cannot open " + fileName;
+        return false;
+    }
+
+    vectors.clear();
+    std::map<long, size_t> index;
+    TextVector* last = nullptr;
+    char line[4096];
+    while (std::fgets(line, sizeof(line), file)) {
+        if (line[0] >= '0' && line[0] <= '9') {
+            char* p = line;
+            long id = std::strtol(p, &p, 10);
+            long long event = std::strtoll(p, &p, 10);
+            while (*p == ' ' || *p == '\t') {
+                p++;
+            }
+            int64_t rawTime = parseRawTime(p);
+            while (*p && *p != ' ' && *p != '\t') {
+                p++;
+            }
+            double value = std::strtod(p, nullptr);
+
+            auto it = index.find(id);
+            if (it == index.end()) {
+                continue;
+            }
+            TextVector& vector = vectors[it->second];
+            vector.data.events.push_back(event);
+            vector.rawTimes.push_back(rawTime);
+            vector.data.times.push_back(rawTime * 1e-12);
+            vector.data.values.push_back(value);
+        } else if (std::strncmp(line, "vector ", 7) == 0) {
+            std::vector<std::string> tokens = tokenize(line);
+            if (tokens.size() < 4) {
+                continue;
+            }
+            index[std::atol(tokens[1].c_str())] = vectors.size();
+            vectors.emplace_back();
+            last = &vectors.back();
+            last->module = tokens[2];
+            last->name = tokens[3];
+        } else if (std::strncmp(line, "attr ", 5) == 0 && last) {
+            std::vector<std::string> tokens = tokenize(line);
+            if (tokens.size() >= 3) {
+                last->attributes[tokens[1]] = tokens[2];
+            }
+        } else if (std::strncmp(line, "run ", 4) == 0) {
+            last = nullptr;
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool loadAll(const std::string& fileName, ColumnarVectorReader& reader, std::vector<ColumnarVectorData>& data, std::string& error)
+{
+    if (!reader.open(fileName, error)) {
+        return false;
+    }
+    data.resize(reader.getVectors().size());
+    for (size_t i = 0; i < data.size(); i++) {
+        if (!reader.load(int(i), data[i], error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+long fileSize(const std::string& fileName)
+{
+    std::FILE* file = std::fopen(fileName.c_str(), "rb");
+    if (!file) {
+        return -1;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+}
+
+int list(const std::string& fileName)
+{
+    ColumnarVectorReader reader;
+    std::string error;
+    if (!reader.open(fileName, error)) {
+        std::fprintf(stderr, "columnar_vectors: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("module,name,samples\n");
+    for (const ColumnarVectorInfo& info : reader.getVectors()) {
+        std::printf("%s,\"%s\",%llu\n", info.module.c_str(), info.name.c_str(), (unsigned long long)info.count);
+    }
+    return 0;
+}
+
+int dump(const std::string& fileName, const std::string& module, const std::string& name)
+{
+    ColumnarVectorReader reader;
+    ColumnarVectorData data;
+    std::string error;
+    if (!reader.open(fileName, error)) {
+        std::fprintf(stderr, "columnar_vectors: %s\n", error.c_str());
+        return 1;
+    }
+    int vector = reader.find(module, name);
+    if (vector < 0) {
+        std::fprintf(stderr, "columnar_vectors: no vector '%s' in %s\n", name.c_str(), module.c_str());
+        return 1;
+    }
+    if (!reader.load(vector, data, error)) {
+        std::fprintf(stderr, "columnar_vectors: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("event,time,value\n");
+    for (size_t i = 0; i < data.values.size(); i++) {
+        std::printf("%lld,%.15g,%.17g\n", (long long)data.events[i], data.times[i], data.values[i]);
+    }
+    return 0;
+}
+
+int convert(const std::string& input, const std::string& output)
+{
+    std::vector<TextVector> vectors;
+    std::string error;
+    if (!readTextVectors(input, vectors, error)) {
+        std::fprintf(stderr, "columnar_vectors: %s\n", error.c_str());
+        return 1;
+    }
+
+    ColumnarVectorWriter writer;
+    if (!writer.open(output, textTimeScaleExp)) {
+        std::fprintf(stderr, "columnar_vectors: cannot write %s\n", output.c_str());
+        return 1;
+    }
+    for (const TextVector& vector : vectors) {
+        int column = writer.addVector(vector.module, vector.name, vector.attributes);
+        for (size_t i = 0; i < vector.data.values.size(); i++) {
+            writer.append(column, vector.data.events[i], vector.rawTimes[i], vector.data.values[i]);
+        }
+    }
+    if (!writer.close()) {
+        std::fprintf(stderr, "columnar_vectors: cannot write %s\n", output.c_str());
+        return 1;
+    }
+    uint64_t samples = writer.getSamplesWritten();
+    std::fprintf(stderr, "columnar_vectors: %zu vectors, %llu samples, %ld -> %ld bytes\n",
+            vectors.size(), (unsigned long long)samples, fileSize(input), fileSize(output));
+    return 0;
+}
+
+int bench(const std::string& columnarFile, const std::string& textFile, int repeat)
+{
+    using Clock = std::chrono::steady_clock;
+    std::string error;
+    size_t samples = 0;
+
+    auto start = Clock::now();
+    for (int r = 0; r < repeat; r++) {
+        ColumnarVectorReader reader;
+        std::vector<ColumnarVectorData> data;
+        if (!loadAll(columnarFile, reader, data, error)) {
+            std::fprintf(stderr, "columnar_vectors: %s\n", error.c_str());
+            return 1;
+        }
+        samples = 0;
+        for (const ColumnarVectorData& d : data) {
+            samples += d.values.size();
+        }
+    }
+    std::chrono::duration<double> columnarTime = (Clock::now() - start) / repeat;
+    std::printf("format,bytes,samples,loadSeconds,samplesPerSecond\n");
+    std::printf("columnar,%ld,%zu,%.6f,%.0f\n", fileSize(columnarFile), samples, columnarTime.count(),
+            samples / columnarTime.count());
+
+    if (textFile.empty()) {
+        return 0;
+    }
+    start = Clock::now();
+    for (int r = 0; r < repeat; r++) {
+        std::vector<TextVector> vectors;
+        if (!readTextVectors(textFile, vectors, error)) {
+            std::fprintf(stderr, "columnar_vectors: %s\n", error.c_str());
+            return 1;
+        }
+        samples = 0;
+        for (const TextVector& v : vectors) {
+            samples += v.data.values.size();
+        }
+    }
+    std::chrono::duration<double> textTime = (Clock::now() - start) / repeat;
+    std::printf("text,%ld,%zu,%.6f,%.0f\n", fileSize(textFile), samples, textTime.count(), samples / textTime.count());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args;
+    int repeat = 5;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--repeat=") == 0) {
+            repeat = std::max(1, std::atoi(arg.c_str() + 9));
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if (args.size() == 2 && args[0] == "list") {
+        return list(args[1]);
+    } else if (args.size() == 4 && args[0] == "dump") {
+        return dump(args[1], args[2], args[3]);
+    } else if (args.size() == 3 && args[0] == "convert") {
+        return convert(args[1], args[2]);
+    } else if ((args.size() == 2 || args.size() == 3) && args[0] == "bench") {
+        return bench(args[1], args.size() == 3 ? args[2] : "", repeat);
+    }
+    usage();
+    return 2;
+}
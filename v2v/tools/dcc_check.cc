@@ -0,0 +1,84 @@
+//
+// Scenario check of DccController, without OMNeT++, Veins or SUMO.
+//
+// Feeds the controller a channel that is busy for a fixed share of every
+// 100 ms measurement period, with the beacon interval of omnetpp.ini (0.5 s)
+// and the NED defaults otherwise. Under a high CBR both modes must beacon
+// slower than configured (adaptive up to dccMaxBeaconInterval, then lower the
+// tx power), and once the channel clears they must return to the configured
+// interval and power. No state may beacon faster or louder than configured.
+//
+//   dcc_check
+//
+// Exits nonzero if a scenario fails. Run by "make check".
+//
+
+#include <algorithm>
+#include <cstdio>
+
+#include "veins/modules/application/traci/DccController.h"
+
+using namespace veins;
+
+namespace {
+
+const double configuredInterval = 0.5;
+const double configuredTxPower = 20.0;
+const double measurementInterval = 0.1;
+
+struct Span {
+    double minInterval;
+    double maxInterval;
+    double minTxPower;
+    double maxTxPower;
+};
+
+// Runs the channel at busyRatio for duration seconds from now
+Span load(DccController& dcc, double& now, double busyRatio, double duration)
+{
+    Span span = {1e9, 0, 1e9, 0};
+    for (double end = now + duration; now < end - 1e-9; now += measurementInterval) {
+        dcc.channelBusy(true, now);
+        dcc.channelBusy(false, now + busyRatio * measurementInterval);
+        dcc.measure(now + measurementInterval);
+        span.minInterval = std::min(span.minInterval, dcc.getBeaconInterval());
+        span.maxInterval = std::max(span.maxInterval, dcc.getBeaconInterval());
+        span.minTxPower = std::min(span.minTxPower, dcc.getTxPower());
+        span.maxTxPower = std::max(span.maxTxPower, dcc.getTxPower());
+    }
+    return span;
+}
+
+bool scenario(const char* name, DccMode mode)
+{
+    DccParams params;
+    params.mode = mode;
+    DccController dcc;
+    dcc.configure(params, configuredInterval, configuredTxPower, 0);
+
+    double now = 0;
+    Span congested = load(dcc, now, 0.9, 30);
+    double congestedInterval = dcc.getBeaconInterval();
+    double congestedTxPower = dcc.getTxPower();
+    Span cleared = load(dcc, now, 0.05, 30);
+
+    bool ok = congestedInterval > configuredInterval && congestedTxPower < configuredTxPower
+              && dcc.getBeaconInterval() == configuredInterval && dcc.getTxPower() == configuredTxPower
+              && congested.minInterval >= configuredInterval && cleared.minInterval >= configuredInterval
+              && congested.maxTxPower <= configuredTxPower && cleared.maxTxPower <= configuredTxPower;
+    if (mode == DccMode::Adaptive) {
+        ok = ok && congestedInterval == params.maxBeaconInterval && congestedTxPower == params.minTxPower;
+    }
+    std::printf("dcc_check: %s: CBR 0.9 -> interval %.3g s, tx power %.3g mW; CBR 0.05 -> %.3g s, %.3g mW: %s\n", name,
+            congestedInterval, congestedTxPower, dcc.getBeaconInterval(), dcc.getTxPower(), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    bool ok = scenario("reactive", DccMode::Reactive);
+    ok = scenario("adaptive", DccMode::Adaptive) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,395 @@
+//
+// Microbenchmarks of the SecurityDetector, without OMNeT++, Veins or SUMO.
+//
+// Drives the detector with synthetic arrival streams (benign beacons, flood
+// bursts, spoofed content, replayed beacons) from 10 to 10000 senders and
+// reports the time per packet of the full receive path and of the individual
+// detection steps, plus the detector memory per sender. validateBatch runs the
+// content checks over the whole stream at once (BeaconBatch) for comparison
+// with validateMessageContent.
+//
+//   detector_bench                          all benchmarks
+//   detector_bench --filter=flood/1000      only names containing the text
+//   detector_bench --min-time=2 --csv       longer runs, CSV output
+//
+// Compare two builds by diffing their --csv output; a regression shows up as a
+// higher ns/packet (time) or bytes/sender (memory) for the same benchmark.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "veins/modules/application/traci/BeaconBatch.h"
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+using namespace veins;
+
+// Live heap bytes, for the memory per sender. Every block carries its size in
+// front of the returned pointer.
+namespace {
+
+size_t liveBytes = 0;
+const size_t sizeHeader = alignof(std::max_align_t);
+
+__attribute__((noinline)) void* countedAlloc(std::size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + sizeHeader));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    liveBytes += size;
+    return block + sizeHeader;
+}
+
+__attribute__((noinline)) void countedFree(void* p)
+{
+    if (p) {
+        char* block = static_cast<char*>(p) - sizeHeader;
+        liveBytes -= *reinterpret_cast<size_t*>(block);
+        std::free(block);
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    countedFree(p);
+}
+
+namespace {
+
+enum class Scenario {
+    Benign,                                        // 10 Hz beacons from every sender
+    Flood,                                         // 10% of the senders burst at 500 Hz
+    Spoof,                                         // 10% of the beacons with impossible content
+    Replay                                         // 10% of the beacons replayed 10 s later
+};
+
+const char* scenarioName(Scenario scenario)
+{
+    switch (scenario) {
+        case Scenario::Benign: return "benign";
+        case Scenario::Flood: return "flood";
+        case Scenario::Spoof: return "spoof";
+        case Scenario::Replay: return "replay";
+    }
+    return "?";
+}
+
+// Time ordered receptions at one receiver
+std::vector<ReceptionEvent> makeStream(Scenario scenario, int senders, size_t events)
+{
+    std::mt19937_64 rng(senders * 31 + int(scenario));
+    std::uniform_real_distribution<double> unit(0, 1);
+    const double beaconInterval = 0.1;
+    const double floodInterval = 0.002;
+
+    // Long enough for every sender to beacon a few times within the budget
+    double duration = std::max(1.0, events * beaconInterval / senders);
+    std::vector<ReceptionEvent> stream;
+    stream.reserve(events + events / 4);
+    for (int sender = 0; sender < senders; sender++) {
+        bool flooding = scenario == Scenario::Flood && sender % 10 == 0;
+        double interval = flooding ? floodInterval : beaconInterval;
+        double x = unit(rng) * 2000;
+        double y = unit(rng) * 2000;
+        for (double t = unit(rng) * interval; t < duration; t += interval) {
+            ReceptionEvent ev;
+            ev.receiverId = senders;
+            ev.senderId = sender;
+            ev.time = t + 0.0002;
+            ev.timestamp = t;
+            ev.posX = x + 13.9 * t;
+            ev.posY = y;
+            ev.speedX = 13.9;
+            if (scenario == Scenario::Spoof && unit(rng) < 0.1) {
+                ev.speedX = 300;
+                ev.posX = std::numeric_limits<double>::quiet_NaN();
+            }
+            stream.push_back(ev);
+            if (scenario == Scenario::Replay && unit(rng) < 0.1) {
+                ReceptionEvent replayed = ev;
+                replayed.time += 10;
+                stream.push_back(replayed);
+            }
+        }
+    }
+    std::sort(stream.begin(), stream.end(), [](const ReceptionEvent& a, const ReceptionEvent& b) {
+        return a.time < b.time;
+    });
+    if (stream.size() > events) {
+        stream.resize(events);
+    }
+    return stream;
+}
+
+struct Result {
+    std::string name;
+    size_t packets = 0;                            // Per iteration
+    long iterations = 0;
+    double nsPerPacket = 0;
+    double bytesPerSender = 0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Runs body (one pass over the stream) until minTime has passed
+template <typename Body>
+Result measure(const std::string& name, size_t packets, double minTime, Body body)
+{
+    Result result;
+    result.name = name;
+    result.packets = packets;
+    double elapsed = 0;
+    while (elapsed < minTime || result.iterations == 0) {
+        auto start = Clock::now();
+        body();
+        elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+        result.iterations++;
+    }
+    result.nsPerPacket = elapsed * 1e9 / (double(packets) * result.iterations);
+    return result;
+}
+
+struct Options {
+    std::vector<int> senders = {10, 100, 1000, 10000};
+    size_t events = 100000;
+    double minTime = 0.5;
+    std::string filter;
+    bool csv = false;
+};
+
+void usage()
+{
+    std::fprintf(stderr,
+            "usage: detector_bench [options]\n"
+            "  --filter=TEXT      run benchmarks whose name contains TEXT\n"
+            "  --senders=LIST     comma separated sender counts (default 10,100,1000,10000)\n"
+            "  --events=N         receptions per stream (default 100000)\n"
+            "  --min-time=S       minimum measuring time per benchmark (default 0.5)\n"
+            "  --csv              CSV instead of a table\n");
+}
+
+bool selected(const Options& options, const std::string& name)
+{
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+void print(const Options& options, const Result& r)
+{
+    if (options.csv) {
+        std::printf("%s,%zu,%ld,%.2f,%.1f\n", r.name.c_str(), r.packets, r.iterations, r.nsPerPacket, r.bytesPerSender);
+    } else {
+        std::printf("%-44s %12.2f %10ld %14.1f\n", r.name.c_str(), r.nsPerPacket, r.iterations, r.bytesPerSender);
+    }
+    std::fflush(stdout);
+}
+
+void runScenario(const Options& options, Scenario scenario, int senders)
+{
+    std::string prefix = std::string(scenarioName(scenario)) + "/" + std::to_string(senders) + "/";
+    std::vector<std::string> names = {"inspect", "updateMessageCounter", "isFloodAttacker", "detectBurstAttack",
+                                      "detectAnomalousTraffic", "validateMessageContent", "validateBatch",
+                                      "gatherValidateBatch"};
+    bool any = false;
+    for (const std::string& name : names) {
+        any = any || selected(options, prefix + name);
+    }
+    if (!any) {
+        return;
+    }
+
+    std::vector<ReceptionEvent> stream = makeStream(scenario, senders, options.events);
+    DetectorParams params;
+
+    // Full receive path from a fresh detector, as MyVeinsApp runs it
+    if (selected(options, prefix + "inspect")) {
+        size_t bytesPerRun = 0;
+        Result r = measure(prefix + "inspect", stream.size(), options.minTime, [&]() {
+            size_t before = liveBytes;
+            SecurityDetector detector(params);
+            for (const ReceptionEvent& ev : stream) {
+                detector.inspect(ev);
+            }
+            bytesPerRun = liveBytes - before;
+        });
+        r.bytesPerSender = double(bytesPerRun) / senders;
+        print(options, r);
+    }
+
+    if (selected(options, prefix + "updateMessageCounter")) {
+        size_t bytesPerRun = 0;
+        Result r = measure(prefix + "updateMessageCounter", stream.size(), options.minTime, [&]() {
+            size_t before = liveBytes;
+            SecurityDetector detector(params);
+            for (const ReceptionEvent& ev : stream) {
+                detector.updateMessageCounter(ev.senderId, ev.time);
+            }
+            bytesPerRun = liveBytes - before;
+        });
+        r.bytesPerSender = double(bytesPerRun) / senders;
+        print(options, r);
+    }
+
+    // The single steps run against a detector that has seen the whole stream
+    SecurityDetector warm(params);
+    for (const ReceptionEvent& ev : stream) {
+        warm.inspect(ev);
+    }
+    volatile long sink = 0;
+
+    if (selected(options, prefix + "isFloodAttacker")) {
+        SecurityDetector detector = warm;
+        print(options, measure(prefix + "isFloodAttacker", stream.size(), options.minTime, [&]() {
+            for (const ReceptionEvent& ev : stream) {
+                sink += detector.isFloodAttacker(ev.senderId, ev.time);
+            }
+        }));
+    }
+
+    if (selected(options, prefix + "detectBurstAttack")) {
+        std::vector<const MessageCounter*> counters;
+        for (const ReceptionEvent& ev : stream) {
+            counters.push_back(&warm.getCounters().at(ev.senderId));
+        }
+        print(options, measure(prefix + "detectBurstAttack", stream.size(), options.minTime, [&]() {
+            for (const MessageCounter* counter : counters) {
+                sink += warm.detectBurstAttack(*counter);
+            }
+        }));
+    }
+
+    if (selected(options, prefix + "detectAnomalousTraffic")) {
+        // Quadratic in the number of senders, so a slice of the stream is enough
+        size_t packets = std::min(stream.size(), std::max<size_t>(100, 2000000 / senders));
+        print(options, measure(prefix + "detectAnomalousTraffic", packets, options.minTime, [&]() {
+            for (size_t i = 0; i < packets; i++) {
+                sink += warm.detectAnomalousTraffic(stream[i].senderId, 10.0);
+            }
+        }));
+    }
+
+    if (selected(options, prefix + "validateMessageContent")) {
+        print(options, measure(prefix + "validateMessageContent", stream.size(), options.minTime, [&]() {
+            for (const ReceptionEvent& ev : stream) {
+                sink += int(warm.validateMessageContent(ev));
+            }
+        }));
+    }
+
+    // The same checks over the stream as one SoA batch, with and without the
+    // cost of gathering the fields
+    if (selected(options, prefix + "validateBatch") || selected(options, prefix + "gatherValidateBatch")) {
+        BeaconBatch batch;
+        batch.assign(stream.data(), stream.size());
+        std::vector<uint8_t> checks(stream.size());
+        validateBatch(batch, params, checks.data());
+        size_t mismatches = 0;
+        for (size_t i = 0; i < stream.size(); i++) {
+            mismatches += checks[i] != uint8_t(warm.validateMessageContent(stream[i]));
+        }
+        if (mismatches > 0) {
+            std::fprintf(stderr, "%svalidateBatch: %zu of %zu checks differ from validateMessageContent\n",
+                    prefix.c_str(), mismatches, stream.size());
+        }
+
+        if (selected(options, prefix + "validateBatch")) {
+            print(options, measure(prefix + "validateBatch", stream.size(), options.minTime, [&]() {
+                sink += validateBatch(batch, params, checks.data());
+            }));
+        }
+        if (selected(options, prefix + "gatherValidateBatch")) {
+            print(options, measure(prefix + "gatherValidateBatch", stream.size(), options.minTime, [&]() {
+                batch.assign(stream.data(), stream.size());
+                sink += validateBatch(batch, params, checks.data());
+            }));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--filter=") == 0) {
+            options.filter = arg.substr(9);
+        } else if (arg.compare(0, 10, "--senders=") == 0) {
+            options.senders.clear();
+            for (const char* p = arg.c_str() + 10; *p;) {
+                char* end;
+                long n = std::strtol(p, &end, 10);
+                if (end == p || n <= 0) {
+                    usage();
+                    return 2;
+                }
+                options.senders.push_back(int(n));
+                p = *end == ',' ? end + 1 : end;
+            }
+        } else if (arg.compare(0, 9, "--events=") == 0) {
+            options.events = std::max(1L, std::atol(arg.c_str() + 9));
+        } else if (arg.compare(0, 11, "--min-time=") == 0) {
+            options.minTime = std::atof(arg.c_str() + 11);
+        } else if (arg == "--csv") {
+            options.csv = true;
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (options.csv) {
+        std::printf("benchmark,packets,iterations,nsPerPacket,bytesPerSender\n");
+    } else {
+        std::printf("%-44s %12s %10s %14s\n", "Benchmark", "ns/packet", "Iterations", "bytes/sender");
+        std::printf("%s\n", std::string(83, '-').c_str());
+    }
+    for (Scenario scenario : {Scenario::Benign, Scenario::Flood, Scenario::Spoof, Scenario::Replay}) {
+        for (int senders : options.senders) {
+            runScenario(options, scenario, senders);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,283 @@
+//
+// Offline replay of a MyVeinsApp detection trace.
+//
+// Runs the SecurityDetector over a recorded trace for every combination of the
+// given thresholds (in parallel) and prints one CSV row per combination with
+// recall, precision and false positive rate, so thresholds can be tuned without
+// re-running the radio and SUMO simulation.
+//
+// Record a trace with:  *.node[*].appl.traceFile = "detection.trace"
+// Then e.g.:            detector_replay --flood=2:10:1 --window=1,3,5 detection.trace
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "veins/modules/application/traci/DetectionTrace.h"
+#include "veins/modules/application/traci/DetectionMetrics.h"
+
+using namespace veins;
+
+namespace {
+
+struct SweepAxis {
+    const char* option;
+    double DetectorParams::*field;
+    std::vector<double> values;
+};
+
+struct ReplayResult {
+    DetectorParams params;
+    DetectionCounts counts;                        // Summed over all receivers
+    long attackPackets = 0;
+    long attackPacketsDropped = 0;
+    long benignPackets = 0;
+    long benignPacketsDropped = 0;
+};
+
+// Receptions of one receiver, in time order
+using ReceiverEvents = std::vector<ReceptionEvent>;
+
+void usage()
+{
+    std::fprintf(stderr,
+            "usage: detector_replay [options] TRACE\n"
+            "\n"
+            "Sweep options take a comma separated list or START:STOP:STEP:\n"
+            "  --flood=LIST        floodThreshold\n"
+            "  --severe=LIST       severeFloodThreshold\n"
+            "  --burst=LIST        burstThreshold\n"
+            "  --anomaly=LIST      anomalyThreshold\n"
+            "  --window=LIST       detectionWindow (s)\n"
+            "  --persistent=LIST   persistentFloodDuration (s)\n"
+            "  --blacklist=LIST    blacklistTimeout (s)\n"
+            "\n"
+            "Other options:\n"
+            "  --no-entropy        disable entropy-based detection\n"
+            "  --no-validation     disable message content validation\n"
+            "  --threads=N         worker threads (default: hardware concurrency)\n"
+            "  --output=FILE       write CSV to FILE instead of stdout\n");
+}
+
+bool parseList(const std::string& text, std::vector<double>& values)
+{
+    values.clear();
+    size_t colon = text.find(':');
+    if (colon != std::string::npos) {
+        double start, stop, step;
+        if (std::sscanf(text.c_str(), "%lf:%lf:%lf", &start, &stop, &step) != 3 || step <= 0) {
+            return false;
+        }
+        for (double v = start; v <= stop + step * 1e-9; v += step) {
+            values.push_back(v);
+        }
+        return !values.empty();
+    }
+
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t comma = text.find(',', pos);
+        std::string item = text.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        char* end = nullptr;
+        double v = std::strtod(item.c_str(), &end);
+        if (item.empty() || *end != '\0') {
+            return false;
+        }
+        values.push_back(v);
+        if (comma == std::string::npos) {
+            break;
+        }
+        pos = comma + 1;
+    }
+    return !values.empty();
+}
+
+ReplayResult replay(const DetectorParams& params, const std::vector<ReceiverEvents>& receivers, const DetectionTrace& trace)
+{
+    ReplayResult result;
+    result.params = params;
+
+    SecurityDetector detector(params);
+    DetectionMetrics metrics;
+
+    for (const ReceiverEvents& events : receivers) {
+        detector.clear();
+        metrics.clear();
+
+        for (const ReceptionEvent& ev : events) {
+            bool attacker = trace.isMalicious(ev.senderId);
+            DetectionResult verdict = detector.inspect(ev);
+            metrics.observe(ev.senderId, attacker, verdict, detector.isBlacklisted(ev.senderId), ev.time);
+
+            bool dropped = verdict.verdict != DetectionVerdict::Accepted;
+            if (attacker) {
+                result.attackPackets++;
+                result.attackPacketsDropped += dropped;
+            } else {
+                result.benignPackets++;
+                result.benignPacketsDropped += dropped;
+            }
+        }
+        result.counts.add(metrics.getCounts());
+    }
+    return result;
+}
+
+double ratio(long part, long whole)
+{
+    return whole > 0 ? (double)part / whole : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<SweepAxis> axes = {
+        {"--flood=", &DetectorParams::floodThreshold, {}},
+        {"--severe=", &DetectorParams::severeFloodThreshold, {}},
+        {"--burst=", &DetectorParams::burstThreshold, {}},
+        {"--anomaly=", &DetectorParams::anomalyThreshold, {}},
+        {"--window=", &DetectorParams::detectionWindow, {}},
+        {"--persistent=", &DetectorParams::persistentFloodDuration, {}},
+        {"--blacklist=", &DetectorParams::blacklistTimeout, {}},
+    };
+
+    DetectorParams base;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string traceFile;
+    std::string outputFile;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool matched = false;
+        for (SweepAxis& axis : axes) {
+            std::string option = axis.option;
+            if (arg.compare(0, option.size(), option) == 0) {
+                if (!parseList(arg.substr(option.size()), axis.values)) {
+                    std::fprintf(stderr, "detector_replay: bad value list in '%s'\n", arg.c_str());
+                    return 2;
+                }
+                matched = true;
+            }
+        }
+        if (matched) {
+            continue;
+        }
+        if (arg == "--no-entropy") {
+            base.entropyBasedDetection = false;
+        } else if (arg == "--no-validation") {
+            base.messageValidation = false;
+        } else if (arg.compare(0, 10, "--threads=") == 0) {
+            threads = std::max(1, std::atoi(arg.c_str() + 10));
+        } else if (arg.compare(0, 9, "--output=") == 0) {
+            outputFile = arg.substr(9);
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else if (arg[0] != '-' && traceFile.empty()) {
+            traceFile = arg;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (traceFile.empty()) {
+        usage();
+        return 2;
+    }
+
+    DetectionTrace trace;
+    std::string error;
+    auto loadStart = std::chrono::steady_clock::now();
+    if (!readDetectionTrace(traceFile, trace, error)) {
+        std::fprintf(stderr, "detector_replay: %s\n", error.c_str());
+        return 1;
+    }
+
+    // Each receiver runs its own detector instance, split the trace accordingly
+    std::map<int, size_t> receiverIndex;
+    std::vector<ReceiverEvents> receivers;
+    for (const ReceptionEvent& ev : trace.events) {
+        if (trace.isMalicious(ev.receiverId)) {
+            continue;
+        }
+        auto it = receiverIndex.emplace(ev.receiverId, receivers.size()).first;
+        if (it->second == receivers.size()) {
+            receivers.emplace_back();
+        }
+        receivers[it->second].push_back(ev);
+    }
+
+    // Expand the sweep grid
+    std::vector<DetectorParams> grid = {base};
+    for (const SweepAxis& axis : axes) {
+        if (axis.values.empty()) {
+            continue;
+        }
+        std::vector<DetectorParams> expanded;
+        for (const DetectorParams& p : grid) {
+            for (double v : axis.values) {
+                DetectorParams q = p;
+                q.*axis.field = v;
+                expanded.push_back(q);
+            }
+        }
+        grid.swap(expanded);
+    }
+
+    auto sweepStart = std::chrono::steady_clock::now();
+    std::vector<ReplayResult> results(grid.size());
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    threads = std::min<unsigned>(threads, grid.size());
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < grid.size(); i = next++) {
+                results[i] = replay(grid[i], receivers, trace);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    auto sweepEnd = std::chrono::steady_clock::now();
+
+    std::FILE* out = stdout;
+    if (!outputFile.empty()) {
+        out = std::fopen(outputFile.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "detector_replay: cannot write %s\n", outputFile.c_str());
+            return 1;
+        }
+    }
+
+    std::fprintf(out, "floodThreshold,severeFloodThreshold,burstThreshold,anomalyThreshold,detectionWindow,"
+                      "persistentFloodDuration,blacklistTimeout,recall,precision,falsePositiveRate,"
+                      "attackPacketDropRate,benignPacketDropRate,meanTimeToDetect\n");
+    for (const ReplayResult& r : results) {
+        const DetectorParams& p = r.params;
+        std::fprintf(out, "%g,%g,%g,%g,%g,%g,%g,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+                p.floodThreshold, p.severeFloodThreshold, p.burstThreshold, p.anomalyThreshold,
+                p.detectionWindow, p.persistentFloodDuration, p.blacklistTimeout,
+                r.counts.recall(), r.counts.precision(), r.counts.falsePositiveRate(),
+                ratio(r.attackPacketsDropped, r.attackPackets),
+                ratio(r.benignPacketsDropped, r.benignPackets),
+                r.counts.meanTimeToDetect());
+    }
+    if (out != stdout) {
+        std::fclose(out);
+    }
+
+    std::chrono::duration<double> loadTime = sweepStart - loadStart;
+    std::chrono::duration<double> sweepTime = sweepEnd - sweepStart;
+    std::fprintf(stderr, "detector_replay: %zu events, %zu receivers, %zu combinations on %u threads; load %.3fs, sweep %.3fs\n",
+            trace.events.size(), receivers.size(), grid.size(), threads, loadTime.count(), sweepTime.count());
+    return 0;
+}
@@ -0,0 +1,339 @@
+//
+// Benchmark driver for the scaling scenarios of tools/scenario_gen.
+//
+// Runs every scenario of scale/scenarios.csv once under Cmdenv and reports
+// wall time, simulated events, events per second and the peak RSS of the
+// simulation process, plus the memory of the detector per module type from
+// the detectorMemory scalars of MyVeinsApp. Run from simulations/v2v with
+// the SUMO launch daemon running (sumo-launchd.py -c sumo):
+//
+//   scale_bench --sim="opp_run -l ../../src/v2v -n ../../src:.:$VEINS/src/veins"
+//   scale_bench --filter=grid --csv > grid.csv
+//
+// The per-module breakdown goes to RESULTDIR/scale-modules.csv. The peak RSS
+// is the OMNeT++ process only, SUMO runs under the launch daemon.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct Scenario {
+    std::string config;
+    std::string layout;
+    int vehicles = 0;
+    int attackers = 0;
+};
+
+struct ModuleMemory {
+    int modules = 0;
+    double total = 0;
+    double max = 0;
+};
+
+struct Run {
+    Scenario scenario;
+    int exitCode = 0;
+    double wallSeconds = 0;
+    long long events = 0;
+    long peakRssKb = 0;
+    std::map<std::string, ModuleMemory> memory;    // By module path, indices as [*]
+};
+
+struct Options {
+    std::string index = "scale/scenarios.csv";
+    std::string ini = "scale/scale.ini";
+    std::string sim = "opp_run";
+    std::string resultDir = "results/scale";
+    std::string filter;
+    bool csv = false;
+    bool dryRun = false;
+};
+
+void usage()
+{
+    std::fprintf(stderr,
+            "usage: scale_bench [options]\n"
+            "  --index=FILE       scenario list (default scale/scenarios.csv)\n"
+            "  --ini=FILE         ini file with the configs (default scale/scale.ini)\n"
+            "  --sim=COMMAND      simulation command (default opp_run)\n"
+            "  --result-dir=DIR   logs and result files (default results/scale)\n"
+            "  --filter=TEXT      run configs whose name contains TEXT\n"
+            "  --csv              CSV instead of a table\n"
+            "  --dry-run          print the commands only\n");
+}
+
+// mkdir -p
+bool makeDirectories(const std::string& path)
+{
+    for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1)) {
+        std::string prefix = path.substr(0, slash);
+        if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+            return false;
+        }
+        if (slash == std::string::npos) {
+            return true;
+        }
+    }
+}
+
+std::vector<Scenario> readIndex(const std::string& fileName)
+{
+    std::vector<Scenario> scenarios;
+    std::ifstream file(fileName);
+    std::string line;
+    std::getline(file, line);                      // Header
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() >= 4) {
+            Scenario scenario;
+            scenario.config = fields[0];
+            scenario.layout = fields[1];
+            scenario.vehicles = std::atoi(fields[2].c_str());
+            scenario.attackers = std::atoi(fields[3].c_str());
+            scenarios.push_back(scenario);
+        }
+    }
+    return scenarios;
+}
+
+std::string readFile(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// Last "event #N" of the Cmdenv output: progress lines while running, the
+// "Simulation time limit reached" line at the end
+long long lastEventNumber(const std::string& log)
+{
+    long long events = 0;
+    for (size_t pos = 0; (pos = log.find("vent #", pos)) != std::string::npos; pos += 6) {
+        if (pos > 0 && (log[pos - 1] == 'e' || log[pos - 1] == 'E')) {
+            events = std::atoll(log.c_str() + pos + 6);
+        }
+    }
+    return events;
+}
+
+// "V2VNetwork.node[12].appl" -> "V2VNetwork.node[*].appl"
+std::string modulePattern(const std::string& module)
+{
+    std::string pattern;
+    for (size_t i = 0; i < module.size(); i++) {
+        if (module[i] == '[') {
+            size_t close = module.find(']', i);
+            if (close != std::string::npos) {
+                pattern += "[*]";
+                i = close;
+                continue;
+            }
+        }
+        pattern += module[i];
+    }
+    return pattern;
+}
+
+void readModuleMemory(const std::string& scalarFile, std::map<std::string, ModuleMemory>& memory)
+{
+    std::ifstream file(scalarFile);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream stream(line);
+        std::string keyword, module, name;
+        double value;
+        if (stream >> keyword >> module >> name >> value && keyword == "scalar" && name == "detectorMemory") {
+            ModuleMemory& entry = memory[modulePattern(module)];
+            entry.modules++;
+            entry.total += value;
+            entry.max = std::max(entry.max, value);
+        }
+    }
+}
+
+// Runs command through the shell with output to logFile; returns the exit
+// code and the peak RSS of the process
+int runCommand(const std::string& command, const std::string& logFile, long& peakRssKb)
+{
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        int fd = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        // exec, so the rusage is the simulation's and not the shell's
+        std::string exec = "exec " + command;
+        execl("/bin/sh", "sh", "-c", exec.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    int status = 0;
+    struct rusage usage;
+    while (wait4(pid, &status, 0, &usage) < 0) {
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+    peakRssKb = usage.ru_maxrss;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+Run runScenario(const Options& options, const Scenario& scenario)
+{
+    Run run;
+    run.scenario = scenario;
+    std::string base = options.resultDir + "/" + scenario.config;
+    std::string command = options.sim + " -u Cmdenv -f " + options.ini + " -c " + scenario.config +
+                          " --cmdenv-express-mode=true --cmdenv-status-frequency=10s"
+                          " --output-scalar-file=" + base + ".sca --output-vector-file=" + base + ".vec";
+    if (options.dryRun) {
+        std::printf("%s\n", command.c_str());
+        return run;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    run.exitCode = runCommand(command, base + ".log", run.peakRssKb);
+    run.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    run.events = lastEventNumber(readFile(base + ".log"));
+    readModuleMemory(base + ".sca", run.memory);
+    return run;
+}
+
+double appMemoryMean(const Run& run)
+{
+    double total = 0;
+    int modules = 0;
+    for (const auto& entry : run.memory) {
+        total += entry.second.total;
+        modules += entry.second.modules;
+    }
+    return modules ? total / modules : 0;
+}
+
+void print(const Options& options, const Run& r)
+{
+    double eventsPerSecond = r.wallSeconds > 0 ? r.events / r.wallSeconds : 0;
+    double rssPerVehicle = r.scenario.vehicles ? double(r.peakRssKb) / r.scenario.vehicles : 0;
+    if (options.csv) {
+        std::printf("%s,%s,%d,%d,%d,%.3f,%lld,%.0f,%ld,%.2f,%.0f\n", r.scenario.config.c_str(),
+                r.scenario.layout.c_str(), r.scenario.vehicles, r.scenario.attackers, r.exitCode, r.wallSeconds, r.events,
+                eventsPerSecond, r.peakRssKb, rssPerVehicle, appMemoryMean(r));
+    } else {
+        std::printf("%-22s %8d %5d %10.1f %12lld %12.0f %10.1f %10.1f %12.0f\n", r.scenario.config.c_str(),
+                r.scenario.vehicles, r.exitCode, r.wallSeconds, r.events, eventsPerSecond, r.peakRssKb / 1024.0,
+                rssPerVehicle, appMemoryMean(r));
+    }
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 8, "--index=") == 0) {
+            options.index = arg.substr(8);
+        } else if (arg.compare(0, 6, "--ini=") == 0) {
+            options.ini = arg.substr(6);
+        } else if (arg.compare(0, 6, "--sim=") == 0) {
+            options.sim = arg.substr(6);
+        } else if (arg.compare(0, 13, "--result-dir=") == 0) {
+            options.resultDir = arg.substr(13);
+        } else if (arg.compare(0, 9, "--filter=") == 0) {
+            options.filter = arg.substr(9);
+        } else if (arg == "--csv") {
+            options.csv = true;
+        } else if (arg == "--dry-run") {
+            options.dryRun = true;
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<Scenario> scenarios = readIndex(options.index);
+    if (scenarios.empty()) {
+        std::fprintf(stderr, "no scenarios in %s, generate them with scenario_gen\n", options.index.c_str());
+        return 1;
+    }
+    if (!options.dryRun && !makeDirectories(options.resultDir)) {
+        std::fprintf(stderr, "cannot create %s\n", options.resultDir.c_str());
+        return 1;
+    }
+
+    if (options.dryRun) {
+        // Commands only
+    } else if (options.csv) {
+        std::printf("config,layout,vehicles,attackers,exitCode,wallSeconds,events,eventsPerSecond,peakRssKb,"
+                    "rssKbPerVehicle,detectorBytesPerModule\n");
+    } else {
+        std::printf("%-22s %8s %5s %10s %12s %12s %10s %10s %12s\n", "Config", "Vehicles", "Exit", "Wall (s)", "Events",
+                "Events/s", "RSS (MB)", "KB/veh", "Det. B/mod");
+        std::printf("%s\n", std::string(110, '-').c_str());
+    }
+
+    std::vector<Run> runs;
+    int failed = 0;
+    for (const Scenario& scenario : scenarios) {
+        if (!options.filter.empty() && scenario.config.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        Run run = runScenario(options, scenario);
+        if (options.dryRun) {
+            continue;
+        }
+        if (run.exitCode != 0) {
+            std::fprintf(stderr, "%s exited with %d, see %s/%s.log\n", scenario.config.c_str(), run.exitCode,
+                    options.resultDir.c_str(), scenario.config.c_str());
+            failed++;
+        }
+        print(options, run);
+        runs.push_back(run);
+    }
+
+    if (!runs.empty()) {
+        std::string modulesFile = options.resultDir + "/scale-modules.csv";
+        std::ofstream modules(modulesFile);
+        modules << "config,vehicles,module,modules,meanBytes,maxBytes,totalBytes\n";
+        for (const Run& run : runs) {
+            for (const auto& entry : run.memory) {
+                const ModuleMemory& m = entry.second;
+                modules << run.scenario.config << "," << run.scenario.vehicles << "," << entry.first << "," << m.modules
+                        << "," << m.total / m.modules << "," << m.max << "," << m.total << "\n";
+            }
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,397 @@
+//
+// Generates SUMO scenarios of increasing size for the scaling runs of
+// V2VNetwork, plus the omnetpp.ini configs that run them.
+//
+// Run from simulations/v2v:
+//   scenario_gen                                   grid and arterial, 500-5000 vehicles
+//   scenario_gen --layout=arterial --vehicles=250,500 --attackers=0.2
+//
+// For every layout and size a directory scale/<layout>-<vehicles>/ is written
+// with the plain network (.nod.xml/.edg.xml, built into net.xml by
+// netconvert), the routes, the SUMO config and the launchd file. The road
+// length grows with the vehicle count so the density stays the same:
+//
+//   grid       single lane streets, priority junctions
+//   arterial   the same grid, every 4th street a faster two lane arterial
+//              with traffic lights where two arterials cross
+//
+// scale/scale.ini includes ../omnetpp.ini and adds one config per scenario
+// (Scale-<layout>-<vehicles>, based on V2VWorking); attackers are spread
+// evenly over the node indices. scale/scenarios.csv lists the scenarios for
+// the benchmark driver, tools/scale_bench.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::string> layouts = {"grid", "arterial"};
+    std::vector<int> vehicles = {500, 1000, 2000, 5000};
+    double attackerRatio = 0.1;
+    double density = 20;                           // Vehicles per lane-km
+    double blockLength = 200;                      // Junction spacing (m)
+    int arterialEvery = 4;                         // Every n-th street is an arterial
+    double duration = 60;                          // sim-time-limit (s)
+    double insertTime = 10;                        // All vehicles depart within (s)
+    unsigned seed = 1;
+    std::string out = "scale";
+    bool netconvert = true;
+};
+
+struct Street {
+    int lanes;
+    double speed;                                  // m/s
+    int priority;
+};
+
+// n x n junctions, node (i, j) at (i * block, j * block)
+struct Grid {
+    std::string layout;
+    int n = 0;
+    double block = 0;
+    int arterialEvery = 0;
+
+    bool arterial(int line) const { return layout == "arterial" && line % arterialEvery == 0; }
+
+    // Street along row or column line, the same in both orientations
+    Street street(int line) const
+    {
+        if (arterial(line)) {
+            return Street{2, 19.44, 3};
+        }
+        return Street{1, 13.89, 1};
+    }
+
+    std::string node(int i, int j) const { return "n" + std::to_string(i) + "_" + std::to_string(j); }
+    std::string edge(int i, int j, int k, int l) const { return node(i, j) + "to" + node(k, l); }
+
+    double laneKm() const
+    {
+        double km = 0;
+        for (int line = 0; line < n; line++) {
+            // Both directions of both street orientations
+            km += 4 * (n - 1) * block / 1000 * street(line).lanes;
+        }
+        return km;
+    }
+
+    double extent() const { return (n - 1) * block; }
+};
+
+void usage()
+{
+    std::fprintf(stderr,
+            "usage: scenario_gen [options]\n"
+            "  --layout=LIST      grid,arterial (default both)\n"
+            "  --vehicles=LIST    comma separated vehicle counts (default 500,1000,2000,5000)\n"
+            "  --attackers=R      share of attacking vehicles (default 0.1)\n"
+            "  --density=D        vehicles per lane-km (default 20)\n"
+            "  --block=M          junction spacing in m (default 200)\n"
+            "  --duration=S       simulated seconds (default 60)\n"
+            "  --insert=S         departures spread over the first S seconds (default 10)\n"
+            "  --seed=N           route seed (default 1)\n"
+            "  --out=DIR          output directory (default scale)\n"
+            "  --no-netconvert    only write .nod.xml/.edg.xml, not net.xml\n");
+}
+
+bool parseList(const std::string& text, std::vector<std::string>& items)
+{
+    items.clear();
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (end == start) {
+            return false;
+        }
+        items.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return !items.empty();
+}
+
+bool makeDirectory(const std::string& path)
+{
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+// Smallest grid with at least the lane length the density asks for
+Grid sizeGrid(const Options& options, const std::string& layout, int vehicles)
+{
+    Grid grid;
+    grid.layout = layout;
+    grid.block = options.blockLength;
+    grid.arterialEvery = options.arterialEvery;
+    double neededKm = vehicles / options.density;
+    for (grid.n = 3; grid.laneKm() < neededKm; grid.n++) {
+    }
+    return grid;
+}
+
+void writeNodes(const Grid& grid, const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    file << "<nodes>\n";
+    for (int i = 0; i < grid.n; i++) {
+        for (int j = 0; j < grid.n; j++) {
+            const char* type = grid.arterial(i) && grid.arterial(j) ? "traffic_light" : "priority";
+            file << "    <node id=\"" << grid.node(i, j) << "\" x=\"" << i * grid.block << "\" y=\"" << j * grid.block
+                 << "\" type=\"" << type << "\"/>\n";
+        }
+    }
+    file << "</nodes>\n";
+}
+
+void writeEdge(std::ofstream& file, const Grid& grid, int i, int j, int k, int l, const Street& street)
+{
+    file << "    <edge id=\"" << grid.edge(i, j, k, l) << "\" from=\"" << grid.node(i, j) << "\" to=\"" << grid.node(k, l)
+         << "\" numLanes=\"" << street.lanes << "\" speed=\"" << street.speed << "\" priority=\"" << street.priority
+         << "\"/>\n";
+}
+
+void writeEdges(const Grid& grid, const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    file << "<edges>\n";
+    for (int line = 0; line < grid.n; line++) {
+        for (int s = 0; s + 1 < grid.n; s++) {
+            Street street = grid.street(line);
+            writeEdge(file, grid, s, line, s + 1, line, street);
+            writeEdge(file, grid, s + 1, line, s, line, street);
+            writeEdge(file, grid, line, s, line, s + 1, street);
+            writeEdge(file, grid, line, s + 1, line, s, street);
+        }
+    }
+    file << "</edges>\n";
+}
+
+// Random walk without U-turns, long enough to keep the vehicle in the network
+// until the end of the run
+std::string randomRoute(const Grid& grid, double length, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> coordinate(0, grid.n - 1);
+    int i = coordinate(rng);
+    int j = coordinate(rng);
+    int fromI = -1;
+    int fromJ = -1;
+    std::string edges;
+    for (double driven = 0; driven < length; driven += grid.block) {
+        const int steps[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        std::vector<std::pair<int, int>> next;
+        for (const auto& step : steps) {
+            int k = i + step[0];
+            int l = j + step[1];
+            if (k >= 0 && k < grid.n && l >= 0 && l < grid.n && !(k == fromI && l == fromJ)) {
+                next.emplace_back(k, l);
+            }
+        }
+        auto chosen = next[std::uniform_int_distribution<size_t>(0, next.size() - 1)(rng)];
+        if (!edges.empty()) {
+            edges += ' ';
+        }
+        edges += grid.edge(i, j, chosen.first, chosen.second);
+        fromI = i;
+        fromJ = j;
+        i = chosen.first;
+        j = chosen.second;
+    }
+    return edges;
+}
+
+void writeRoutes(const Options& options, const Grid& grid, int vehicles, const std::string& fileName)
+{
+    std::mt19937 rng(options.seed * 7919 + vehicles);
+    // At arterial speed for the whole run, with some margin
+    double routeLength = options.duration * 19.44 * 1.5;
+
+    std::ofstream file(fileName);
+    file << "<routes>\n";
+    file << "    <vType id=\"car\" accel=\"2.6\" decel=\"4.5\" sigma=\"0.5\" length=\"5\" minGap=\"2.5\" maxSpeed=\"33.33\"/>\n";
+    for (int v = 0; v < vehicles; v++) {
+        double depart = options.insertTime * v / vehicles;
+        file << "    <vehicle id=\"v" << v << "\" type=\"car\" depart=\"" << depart
+             << "\" departLane=\"best\" departPos=\"random_free\">\n";
+        file << "        <route edges=\"" << randomRoute(grid, routeLength, rng) << "\"/>\n";
+        file << "    </vehicle>\n";
+    }
+    file << "</routes>\n";
+}
+
+void writeSumoConfig(const Options& options, const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    file << "<configuration>\n"
+         << "    <input>\n"
+         << "        <net-file value=\"net.net.xml\"/>\n"
+         << "        <route-files value=\"routes.rou.xml\"/>\n"
+         << "    </input>\n"
+         << "    <time>\n"
+         << "        <begin value=\"0\"/>\n"
+         << "        <end value=\"" << options.duration + 10 << "\"/>\n"
+         << "    </time>\n"
+         << "    <processing>\n"
+         << "        <time-to-teleport value=\"120\"/>\n"
+         << "    </processing>\n"
+         << "    <report>\n"
+         << "        <no-step-log value=\"true\"/>\n"
+         << "    </report>\n"
+         << "</configuration>\n";
+}
+
+void writeLaunchConfig(const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    file << "<launch>\n"
+         << "    <copy file=\"net.net.xml\"/>\n"
+         << "    <copy file=\"routes.rou.xml\"/>\n"
+         << "    <copy file=\"scenario.sumocfg\" type=\"config\"/>\n"
+         << "    <configuration>\n"
+         << "        <step-length value=\"0.1\"/>\n"
+         << "        <arg value=\"--no-step-log\"/>\n"
+         << "        <arg value=\"--no-duration-log\"/>\n"
+         << "        <arg value=\"--no-warnings\"/>\n"
+         << "    </configuration>\n"
+         << "</launch>\n";
+}
+
+void writeIniConfig(std::ofstream& ini, const Options& options, const Grid& grid, const std::string& name, int vehicles)
+{
+    double extent = grid.extent();
+    int attackers = int(std::floor(vehicles * options.attackerRatio));
+    ini << "\n[Config Scale-" << name << "]\n"
+        << "description = \"" << grid.layout << ", " << vehicles << " vehicles (" << attackers << " attackers), "
+        << grid.n << "x" << grid.n << " junctions\"\n"
+        << "extends = V2VWorking\n"
+        << "*.manager.launchConfig = xmldoc(\"" << name << "/sumo.launchd.xml\")\n"
+        << "*.playgroundSizeX = " << extent + 200 << "m\n"
+        << "*.playgroundSizeY = " << extent + 200 << "m\n"
+        << "# Node i attacks when floor(i * ratio) steps up, so any prefix of the nodes\n"
+        << "# holds the same share of attackers\n"
+        << "*.node[*].appl.malicious = floor((ancestorIndex(1) + 1) * " << options.attackerRatio
+        << ") > floor(ancestorIndex(1) * " << options.attackerRatio << ")\n"
+        << "*.node[*].appl.attackType = \"flood\"\n"
+        << "*.node[*].appl.attackInterval = 2\n"
+        << "*.node[*].appl.floodThreshold = 3\n";
+    for (int r = 0; r < 3; r++) {
+        double at = extent * (r + 1) / 4;
+        ini << "*.rsu[" << r << "].mobility.x = " << at << "\n"
+            << "*.rsu[" << r << "].mobility.y = " << at << "\n";
+    }
+    ini << "sim-time-limit = " << options.duration << "s\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::vector<std::string> items;
+        if (arg.compare(0, 9, "--layout=") == 0 && parseList(arg.substr(9), items)) {
+            for (const std::string& layout : items) {
+                if (layout != "grid" && layout != "arterial") {
+                    usage();
+                    return 2;
+                }
+            }
+            options.layouts = items;
+        } else if (arg.compare(0, 11, "--vehicles=") == 0 && parseList(arg.substr(11), items)) {
+            options.vehicles.clear();
+            for (const std::string& item : items) {
+                int n = std::atoi(item.c_str());
+                if (n <= 0) {
+                    usage();
+                    return 2;
+                }
+                options.vehicles.push_back(n);
+            }
+        } else if (arg.compare(0, 12, "--attackers=") == 0) {
+            options.attackerRatio = std::atof(arg.c_str() + 12);
+        } else if (arg.compare(0, 10, "--density=") == 0) {
+            options.density = std::atof(arg.c_str() + 10);
+        } else if (arg.compare(0, 8, "--block=") == 0) {
+            options.blockLength = std::atof(arg.c_str() + 8);
+        } else if (arg.compare(0, 11, "--duration=") == 0) {
+            options.duration = std::atof(arg.c_str() + 11);
+        } else if (arg.compare(0, 9, "--insert=") == 0) {
+            options.insertTime = std::atof(arg.c_str() + 9);
+        } else if (arg.compare(0, 7, "--seed=") == 0) {
+            options.seed = unsigned(std::atol(arg.c_str() + 7));
+        } else if (arg.compare(0, 6, "--out=") == 0) {
+            options.out = arg.substr(6);
+        } else if (arg == "--no-netconvert") {
+            options.netconvert = false;
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (options.attackerRatio < 0 || options.attackerRatio > 1 || options.density <= 0 || options.blockLength <= 0 ||
+            options.duration <= 0 || options.insertTime < 0) {
+        usage();
+        return 2;
+    }
+
+    if (!makeDirectory(options.out)) {
+        std::fprintf(stderr, "cannot create %s\n", options.out.c_str());
+        return 1;
+    }
+    std::ofstream ini(options.out + "/scale.ini");
+    ini << "# Scaling scenarios, generated by tools/scenario_gen; run from simulations/v2v\n"
+        << "# with -f " << options.out << "/scale.ini -c Scale-<layout>-<vehicles>, or all of\n"
+        << "# them with tools/scale_bench.\n"
+        << "include ../omnetpp.ini\n";
+    std::ofstream index(options.out + "/scenarios.csv");
+    index << "config,layout,vehicles,attackers,junctions,laneKm\n";
+
+    for (const std::string& layout : options.layouts) {
+        for (int vehicles : options.vehicles) {
+            Grid grid = sizeGrid(options, layout, vehicles);
+            std::string name = layout + "-" + std::to_string(vehicles);
+            std::string dir = options.out + "/" + name;
+            if (!makeDirectory(dir)) {
+                std::fprintf(stderr, "cannot create %s\n", dir.c_str());
+                return 1;
+            }
+            writeNodes(grid, dir + "/net.nod.xml");
+            writeEdges(grid, dir + "/net.edg.xml");
+            writeRoutes(options, grid, vehicles, dir + "/routes.rou.xml");
+            writeSumoConfig(options, dir + "/scenario.sumocfg");
+            writeLaunchConfig(dir + "/sumo.launchd.xml");
+
+            if (options.netconvert) {
+                std::string command = "netconvert --no-internal-links --no-turnarounds"
+                                      " --node-files=" + dir + "/net.nod.xml --edge-files=" + dir + "/net.edg.xml"
+                                      " --output-file=" + dir + "/net.net.xml --no-warnings > /dev/null";
+                if (std::system(command.c_str()) != 0) {
+                    std::fprintf(stderr, "netconvert failed for %s (is SUMO on the PATH?)\n", name.c_str());
+                    return 1;
+                }
+            }
+
+            writeIniConfig(ini, options, grid, name, vehicles);
+            index << "Scale-" << name << "," << layout << "," << vehicles << ","
+                  << int(std::floor(vehicles * options.attackerRatio)) << "," << grid.n * grid.n << "," << grid.laneKm()
+                  << "\n";
+            std::printf("%-24s %5d vehicles  %2dx%-2d junctions  %7.1f lane-km\n", name.c_str(), vehicles, grid.n,
+                    grid.n, grid.laneKm());
+        }
+    }
+    return 0;
+}
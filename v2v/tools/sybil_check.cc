@@ -0,0 +1,181 @@
+//
+// Scenario check of SybilDetector, without OMNeT++, Veins or SUMO.
+//
+// One receiver hears beacons with a free-space received power and up to 1 ms
+// of channel access delay; every sender beacons once per second plus up to
+// the beacon jitter the Sybil configurations set in MyVeinsApp (100 ms).
+// Scenarios:
+//
+//   standalone   one radio beaconing under 5 identities 10 m apart must be
+//                flagged, and forgetting identities must shrink the cluster
+//   queue        20 honest vehicles 7.5 m apart that start beaconing in the
+//                same step must never be flagged, with and without the
+//                attacker among them, over --runs seeds of 300 s each
+//
+// Queue runs without jitter are reported for comparison only: vehicles that
+// stay in phase are indistinguishable from forged identities.
+//
+//   sybil_check
+//   sybil_check --runs=N --seed=S
+//
+// Exits nonzero if a scenario fails. Run by "make check".
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "veins/modules/application/traci/SybilDetector.h"
+
+using namespace veins;
+
+namespace {
+
+const double beaconInterval = 1.0;
+const double beaconJitter = 0.1;
+const double maxAccessDelay = 0.001;
+const double duration = 300.0;
+
+const int queueLength = 20;
+const double queueStart = 100.0;
+const double queueGap = 7.5;
+
+const int attackerIdentities = 5;
+const int firstForgedId = 1000;
+const double attackerX = 140.0;
+const double sybilSpacing = 10.0;
+
+struct Reception {
+    double time;
+    int senderId;
+    double posX;
+    double rssi;
+};
+
+double rssiAt(double distance)
+{
+    return -40.0 - 20.0 * std::log10(distance);
+}
+
+// Beacons of one radio from its first send on; identities > 1 sends a burst
+// of back to back frames claiming positions sybilSpacing apart
+void beacon(std::vector<Reception>& out, std::mt19937& rng, double jitter, double first, int senderId, double posX,
+        int identities)
+{
+    std::uniform_real_distribution<double> unit(0, 1);
+    for (double t = first; t < duration; t += beaconInterval + jitter * unit(rng)) {
+        double at = t + maxAccessDelay * unit(rng);
+        for (int k = 0; k < identities; k++) {
+            out.push_back({at + k * maxAccessDelay / 2, senderId + k, posX + k * sybilSpacing, rssiAt(posX)});
+        }
+    }
+}
+
+struct Outcome {
+    int honestFlagged = 0;
+    int forgedFlagged = 0;
+};
+
+Outcome run(unsigned seed, double jitter, bool queue, bool attacker, SybilDetector& detector)
+{
+    std::mt19937 rng(seed);
+    std::vector<Reception> receptions;
+    if (queue) {
+        for (int i = 0; i < queueLength; i++) {
+            beacon(receptions, rng, jitter, 0.1, i, queueStart + i * queueGap, 1);
+        }
+    }
+    if (attacker) {
+        beacon(receptions, rng, jitter, 0.1, firstForgedId, attackerX, attackerIdentities);
+    }
+    std::sort(receptions.begin(), receptions.end(), [](const Reception& a, const Reception& b) {
+        return a.time < b.time;
+    });
+
+    detector.clear();
+    Outcome outcome;
+    std::vector<bool> flagged(queueLength + attackerIdentities, false);
+    for (const Reception& r : receptions) {
+        ReceptionEvent ev;
+        ev.time = r.time;
+        ev.timestamp = r.time;
+        ev.senderId = r.senderId;
+        ev.posX = r.posX;
+        ev.posY = 0;
+        if (detector.observe(ev, r.rssi)) {
+            int index = r.senderId < firstForgedId ? r.senderId : queueLength + r.senderId - firstForgedId;
+            if (!flagged[index]) {
+                flagged[index] = true;
+                (r.senderId < firstForgedId ? outcome.honestFlagged : outcome.forgedFlagged)++;
+            }
+        }
+    }
+    return outcome;
+}
+
+bool standalone(unsigned seed)
+{
+    SybilDetector detector;
+    Outcome outcome = run(seed, beaconJitter, false, true, detector);
+    bool ok = outcome.forgedFlagged == attackerIdentities && detector.countSybil() == attackerIdentities;
+
+    // Evicted identities leave the cluster
+    for (int k = 0; k < attackerIdentities - 2; k++) {
+        detector.forget(firstForgedId + k);
+    }
+    int remaining = detector.clusterSize(firstForgedId + attackerIdentities - 1);
+    ok = ok && remaining == 2 && detector.countSybil() == 0 && detector.getSenderCount() == 2;
+
+    std::printf("sybil_check: standalone: %d of %d identities flagged, %d left linked after evicting %d: %s\n",
+            outcome.forgedFlagged, attackerIdentities, remaining, attackerIdentities - 2, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+bool queue(unsigned seed, int runs, bool attacker)
+{
+    SybilDetector detector;
+    int honest = 0;
+    int forgedMissed = 0;
+    int lockstep = 0;
+    for (int i = 0; i < runs; i++) {
+        Outcome outcome = run(seed + i, beaconJitter, true, attacker, detector);
+        honest += outcome.honestFlagged;
+        forgedMissed += attackerIdentities * attacker - outcome.forgedFlagged;
+        lockstep += run(seed + i, 0.0, true, attacker, detector).honestFlagged;
+    }
+    bool ok = honest == 0 && forgedMissed == 0;
+    std::printf("sybil_check: queue%s: %d of %d honest vehicles flagged over %d runs, %d without jitter%s: %s\n",
+            attacker ? " with attacker" : "", honest, queueLength * runs, runs, lockstep,
+            attacker ? (forgedMissed ? ", forged identities missed" : ", all forged identities flagged") : "",
+            ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int runs = 50;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--runs=", 7) == 0) {
+            runs = std::atoi(argv[i] + 7);
+        }
+        else if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = unsigned(std::atol(argv[i] + 7));
+        }
+        else {
+            std::fprintf(stderr, "usage: sybil_check [--runs=N] [--seed=S]\n");
+            return 2;
+        }
+    }
+
+    bool ok = standalone(seed);
+    ok = queue(seed, runs, false) && ok;
+    ok = queue(seed, runs, true) && ok;
+    return ok ? 0 : 1;
+}
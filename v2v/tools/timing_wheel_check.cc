@@ -0,0 +1,255 @@
+//
+// Randomized check of TimingWheel against a reference map of timers, without
+// OMNeT++, Veins or SUMO.
+//
+// Random steps schedule timers from the past to beyond the wheel's horizon
+// (including exact multiples of the tick), cancel live and stale handles,
+// advance by a tick up to a few level-3 slots, and now and then clear the
+// wheel. The fire callback schedules and cancels timers itself. Every timer
+// must fire exactly once, at the first tick at or after its time (the next
+// tick if that has passed), and never once cancelled.
+//
+//   timing_wheel_check                      default seed and step count
+//   timing_wheel_check --steps=N --seed=S
+//
+// Exits nonzero on the first mismatch. Run by "make check".
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "veins/modules/application/traci/TimingWheel.h"
+
+using namespace veins;
+
+namespace {
+
+const double tickLength = 0.1;
+const uint64_t horizon = uint64_t(1) << 24;        // 64^4 ticks
+
+struct Expected {
+    TimingWheel::TimerId id;
+    uint64_t tick;                                 // Tick it fires at
+    int kind;
+};
+
+class Checker {
+public:
+    explicit Checker(unsigned seed)
+        : rng(seed), wheel(tickLength) {}
+
+    bool step()
+    {
+        unsigned op = rng() % 100;
+        if (op < 45) {
+            schedule();
+        }
+        else if (op < 60) {
+            cancelLive();
+        }
+        else if (op < 65) {
+            cancelStale();
+        }
+        else if (op < 99) {
+            if (!advance()) {
+                return false;
+            }
+        }
+        else if (rng() % 50 == 0) {
+            wheel.clear();
+            for (const auto& entry : timers) {
+                stale.push_back(entry.second.id);
+            }
+            timers.clear();
+        }
+        return consistent();
+    }
+
+    size_t fired = 0;
+    size_t maxSize = 0;
+
+private:
+    uint64_t currentTick() const { return uint64_t(std::llround(wheel.getTime() / tickLength)); }
+
+    void schedule()
+    {
+        // Offsets in ticks from now: whole ones are exactly on a tick, the
+        // rest well between two, so the expected tick is exact
+        uint64_t now = currentTick();
+        double offset;
+        switch (rng() % 8) {
+        case 0:
+            offset = -double(rng() % 100);                                     // Past
+            break;
+        case 1:
+            offset = double(rng() % 200);
+            break;
+        case 2:
+            offset = double(rng() % (1 << 18)) + 0.5;
+            break;
+        case 3:
+            if (rng() % 20 == 0) {
+                offset = double(horizon + rng() % horizon);                    // Beyond the horizon
+                break;
+            }
+            // Fall through
+        default:
+            offset = double(rng() % 500) + std::uniform_real_distribution<double>(0.01, 0.99)(rng);
+        }
+        int key = nextKey++;
+        int kind = int(rng() % 4);
+        TimingWheel::TimerId id = wheel.schedule((double(now) + offset) * tickLength, key, kind);
+
+        double ticks = double(now) + std::ceil(offset);
+        uint64_t tick = ticks > double(now) ? uint64_t(ticks) : now + 1;
+        timers[key] = {id, tick, kind};
+        if (timers.size() > maxSize) {
+            maxSize = timers.size();
+        }
+    }
+
+    void cancelLive()
+    {
+        if (timers.empty()) {
+            return;
+        }
+        auto it = timers.lower_bound(int(rng() % unsigned(nextKey)));
+        if (it == timers.end()) {
+            it = timers.begin();
+        }
+        wheel.cancel(it->second.id);
+        stale.push_back(it->second.id);
+        timers.erase(it);
+    }
+
+    void cancelStale()
+    {
+        if (!stale.empty()) {
+            wheel.cancel(stale[rng() % stale.size()]);
+        }
+        wheel.cancel(TimingWheel::InvalidTimer);
+    }
+
+    bool advance()
+    {
+        uint64_t ticks;
+        unsigned size = rng() % 1000;
+        if (size == 0) {
+            ticks = 4096 + rng() % (3 * 262144);           // A few level-3 slots
+        }
+        else if (size < 50) {
+            ticks = rng() % 8192;
+        }
+        else {
+            ticks = rng() % 40;
+        }
+        uint64_t target = currentTick() + ticks;
+        bool ok = true;
+        wheel.advance(double(target) * tickLength, [&](int key, int kind) {
+            auto it = timers.find(key);
+            uint64_t now = currentTick();
+            if (it == timers.end() || it->second.tick != now || it->second.kind != kind) {
+                if (ok) {
+                    std::fprintf(stderr, "timing_wheel_check: timer %d fired at tick %llu, expected %s%llu\n", key,
+                            (unsigned long long)now, it == timers.end() ? "never " : "",
+                            it == timers.end() ? 0ULL : (unsigned long long)it->second.tick);
+                }
+                ok = false;
+                return;
+            }
+            stale.push_back(it->second.id);
+            timers.erase(it);
+            fired++;
+
+            // Callbacks may reschedule and cancel
+            if (rng() % 4 == 0) {
+                schedule();
+            }
+            if (rng() % 8 == 0) {
+                cancelLive();
+            }
+        });
+        if (!ok) {
+            return false;
+        }
+        if (currentTick() != target) {
+            std::fprintf(stderr, "timing_wheel_check: advanced to tick %llu, expected %llu\n",
+                    (unsigned long long)currentTick(), (unsigned long long)target);
+            return false;
+        }
+        for (const auto& entry : timers) {
+            if (entry.second.tick <= target) {
+                std::fprintf(stderr, "timing_wheel_check: timer %d due at tick %llu did not fire by %llu\n", entry.first,
+                        (unsigned long long)entry.second.tick, (unsigned long long)target);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool consistent()
+    {
+        if (wheel.size() != timers.size()) {
+            std::fprintf(stderr, "timing_wheel_check: wheel holds %zu timers, expected %zu\n", wheel.size(), timers.size());
+            return false;
+        }
+        for (int i = 0; i < 4 && !timers.empty(); i++) {
+            auto it = timers.lower_bound(int(rng() % unsigned(nextKey)));
+            if (it != timers.end() && !wheel.isScheduled(it->second.id)) {
+                std::fprintf(stderr, "timing_wheel_check: timer %d is not scheduled\n", it->first);
+                return false;
+            }
+        }
+        if (!stale.empty() && wheel.isScheduled(stale[rng() % stale.size()])) {
+            std::fprintf(stderr, "timing_wheel_check: a fired, cancelled or cleared handle is still scheduled\n");
+            return false;
+        }
+        if (stale.size() > 100000) {
+            stale.erase(stale.begin(), stale.begin() + 50000);
+        }
+        return true;
+    }
+
+    std::mt19937 rng;
+    TimingWheel wheel;
+    std::map<int, Expected> timers;                // Key -> expected firing
+    std::vector<TimingWheel::TimerId> stale;       // Handles no longer scheduled
+    int nextKey = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long steps = 200000;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--steps=", 8) == 0) {
+            steps = std::atol(argv[i] + 8);
+        }
+        else if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = unsigned(std::atol(argv[i] + 7));
+        }
+        else {
+            std::fprintf(stderr, "usage: timing_wheel_check [--steps=N] [--seed=S]\n");
+            return 2;
+        }
+    }
+
+    Checker checker(seed);
+    for (long i = 0; i < steps; i++) {
+        if (!checker.step()) {
+            std::fprintf(stderr, "timing_wheel_check: failed at step %ld\n", i);
+            return 1;
+        }
+    }
+    std::printf("timing_wheel_check: %ld steps ok, %zu timers fired, up to %zu scheduled\n", steps, checker.fired,
+            checker.maxSize);
+    return 0;
+}
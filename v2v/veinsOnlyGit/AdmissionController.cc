@@ -0,0 +1,68 @@
+#include "veins/modules/application/traci/AdmissionController.h"
+#include <algorithm>
+
+using namespace veins;
+
+AdmissionDecision AdmissionController::admit(int senderId, double now) {
+    if (senderId < 0) {
+        return AdmissionDecision::Admitted;
+    }
+
+    if (blocked.test(senderId)) {
+        SenderState& state = stateFor(senderId);
+        if (now < state.blockedUntil) {
+            return AdmissionDecision::Blacklisted;
+        }
+        // Block expired, let the detector have another look
+        blocked.reset(senderId);
+    }
+
+    if (params.rateLimit <= 0) {
+        return AdmissionDecision::Admitted;
+    }
+
+    SenderState& state = stateFor(senderId);
+    if (state.tokens < 0) {
+        state.tokens = params.burstSize;
+    } else {
+        state.tokens = std::min(params.burstSize, state.tokens + (now - state.lastRefill) * params.rateLimit);
+    }
+    state.lastRefill = now;
+
+    if (state.tokens < 1.0) {
+        return AdmissionDecision::RateLimited;
+    }
+    state.tokens -= 1.0;
+    return AdmissionDecision::Admitted;
+}
+
+void AdmissionController::block(int senderId, double until) {
+    if (senderId < 0) {
+        return;
+    }
+    SenderState& state = stateFor(senderId);
+    state.blockedUntil = std::max(state.blockedUntil, until);
+    blocked.set(senderId);
+}
+
+void AdmissionController::unblock(int senderId) {
+    blocked.reset(senderId);
+    auto it = senders.find(senderId);
+    if (it != senders.end()) {
+        it->second.blockedUntil = 0;
+    }
+}
+
+void AdmissionController::forget(int senderId) {
+    blocked.reset(senderId);
+    senders.erase(senderId);
+}
+
+void AdmissionController::clear() {
+    blocked.clear();
+    senders.clear();
+}
+
+AdmissionController::SenderState& AdmissionController::stateFor(int senderId) {
+    return senders[senderId];
+}
@@ -0,0 +1,56 @@
+#ifndef ADMISSIONCONTROLLER_H
+#define ADMISSIONCONTROLLER_H
+
+#include <unordered_map>
+#include "veins/modules/application/traci/SenderBitmap.h"
+
+// Per-sender admission decision taken below the application: a blacklist bit
+// test first, then a token bucket that caps the rate any single sender can
+// push up the stack. Like the detector core this has no OMNeT++ dependencies.
+
+namespace veins {
+
+struct AdmissionParams {
+    double rateLimit = 50.0;                       // Tokens per second per sender, <= 0 disables
+    double burstSize = 25.0;                       // Bucket depth (frames)
+};
+
+enum class AdmissionDecision {
+    Admitted,
+    Blacklisted,                                   // Sender blocked by the detector
+    RateLimited                                    // Sender's token bucket is empty
+};
+
+class AdmissionController {
+public:
+    void setParams(const AdmissionParams& p) { params = p; }
+    const AdmissionParams& getParams() const { return params; }
+
+    AdmissionDecision admit(int senderId, double now);
+
+    // Drop everything from senderId until the given time
+    void block(int senderId, double until);
+    void unblock(int senderId);
+    void forget(int senderId);                     // Drop all state of a sender gone idle
+    bool isBlocked(int senderId) const { return blocked.test(senderId); }
+    int countBlocked() const { return blocked.count(); }
+
+    void clear();
+
+private:
+    struct SenderState {
+        double tokens = -1;                        // < 0 until the first frame
+        double lastRefill = 0;
+        double blockedUntil = 0;
+    };
+
+    SenderState& stateFor(int senderId);
+
+    AdmissionParams params;
+    SenderBitmap blocked;                          // Fast path blacklist test
+    std::unordered_map<int, SenderState> senders;  // Keyed by the (sender-chosen) ID
+};
+
+} // namespace veins
+
+#endif // ADMISSIONCONTROLLER_H
@@ -0,0 +1,77 @@
+#include "veins/modules/application/traci/AdmissionFilter.h"
+#include "veins/modules/messages/MyMsg_m.h"
+
+using namespace veins;
+
+Define_Module(veins::AdmissionFilter);
+
+void AdmissionFilter::initialize() {
+    enabled = par("enabled");
+
+    AdmissionParams params;
+    params.rateLimit = par("rateLimit");
+    params.burstSize = par("burstSize");
+    if (params.rateLimit > 0 && params.burstSize < 1) {
+        throw cRuntimeError("burstSize must allow at least one frame when rate limiting is enabled");
+    }
+    controller.setParams(params);
+
+    framesFilteredVector.setName("Frames Filtered");
+}
+
+void AdmissionFilter::handleMessage(cMessage* msg) {
+    if (enabled) {
+        if (auto myMsg = dynamic_cast<MyMsg*>(msg)) {
+            AdmissionDecision decision = controller.admit(myMsg->getSrcId(), simTime().dbl());
+            if (decision != AdmissionDecision::Admitted) {
+                if (decision == AdmissionDecision::Blacklisted) {
+                    framesBlacklisted++;
+                } else {
+                    framesRateLimited++;
+                }
+                framesFilteredVector.record(framesBlacklisted + framesRateLimited);
+                delete msg;
+                return;
+            }
+        }
+    }
+
+    framesAdmitted++;
+    send(msg, "upperLayerOut");
+}
+
+void AdmissionFilter::block(int senderId, simtime_t until) {
+    Enter_Method_Silent();
+    controller.block(senderId, until.dbl());
+}
+
+void AdmissionFilter::unblock(int senderId) {
+    Enter_Method_Silent();
+    controller.unblock(senderId);
+}
+
+void AdmissionFilter::forget(int senderId) {
+    Enter_Method_Silent();
+    controller.forget(senderId);
+}
+
+void AdmissionFilter::reportProcessingCost(double seconds) {
+    processingCostSum += seconds;
+    processingCostSamples++;
+}
+
+void AdmissionFilter::finish() {
+    long framesFiltered = framesBlacklisted + framesRateLimited;
+    double meanCost = processingCostSamples > 0 ? processingCostSum / processingCostSamples : 0;
+
+    recordScalar("admissionFramesAdmitted", framesAdmitted);
+    recordScalar("admissionFramesBlacklisted", framesBlacklisted);
+    recordScalar("admissionFramesRateLimited", framesRateLimited);
+    recordScalar("admissionMeanProcessingCost", meanCost, "s");
+    // Estimate: every dropped frame would have cost the mean application time
+    recordScalar("admissionCpuTimeSaved", framesFiltered * meanCost, "s");
+
+    EV_INFO << "Admission filter: " << framesAdmitted << " admitted, "
+            << framesBlacklisted << " blacklisted, " << framesRateLimited << " rate limited"
+            << " | Estimated CPU saved: " << framesFiltered * meanCost * 1000 << "ms" << endl;
+}
@@ -0,0 +1,46 @@
+#ifndef ADMISSIONFILTER_H
+#define ADMISSIONFILTER_H
+
+#include <omnetpp.h>
+#include "veins/veins.h"
+#include "veins/modules/application/traci/AdmissionController.h"
+
+using namespace omnetpp;
+
+namespace veins {
+
+// Sits between Mac1609_4 and the application (see SecureCar.ned) and discards
+// frames from blacklisted or rate-exceeding senders before the application
+// spends any time on them. The application pushes its blacklist decisions via
+// block() and reports its own per-frame cost, from which the CPU time saved
+// by filtering is estimated.
+class AdmissionFilter : public cSimpleModule {
+public:
+    void block(int senderId, simtime_t until);
+    void unblock(int senderId);
+    void forget(int senderId);
+
+    // Wall-clock seconds the application spent on one received frame
+    void reportProcessingCost(double seconds);
+
+protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage* msg) override;
+    virtual void finish() override;
+
+private:
+    AdmissionController controller;
+    bool enabled = true;
+
+    // ==================== STATISTICS ====================
+    long framesAdmitted = 0;                       // Passed up to the application
+    long framesBlacklisted = 0;                    // Dropped, sender blacklisted
+    long framesRateLimited = 0;                    // Dropped, token bucket empty
+    double processingCostSum = 0;                  // Application cost of admitted frames (s)
+    long processingCostSamples = 0;
+    cOutVector framesFilteredVector;               // Cumulative frames dropped
+};
+
+} // namespace veins
+
+#endif // ADMISSIONFILTER_H
@@ -0,0 +1,57 @@
+#include "veins/modules/application/traci/AppStateStore.h"
+#include <fstream>
+#include <sstream>
+
+using namespace veins;
+
+namespace {
+
+const char stateHeader[] = "# v2v-app-state 1";
+
+} // namespace
+
+const AppCounters* AppStateStore::find(const std::string& vehicleId) const {
+    auto it = vehicles.find(vehicleId);
+    return it == vehicles.end() ? nullptr : &it->second;
+}
+
+bool AppStateStore::save(const std::string& fileName) const {
+    std::ofstream out(fileName);
+    if (!out) {
+        return false;
+    }
+    out << stateHeader << '\n';
+    for (const auto& entry : vehicles) {
+        const AppCounters& c = entry.second;
+        out << entry.first << ' ' << c.attackCounter << ' ' << c.normalPacketsSent << ' ' << c.attackPacketsSent
+            << ' ' << c.packetsReceived << ' ' << c.attacksDetected << ' ' << c.packetsSent
+            << ' ' << c.totalDetections << ' ' << c.highRateDetections << ' ' << c.packetsBlocked
+            << ' ' << c.falsePositives << '\n';
+    }
+    return bool(out);
+}
+
+bool AppStateStore::load(const std::string& fileName) {
+    std::ifstream in(fileName);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != stateHeader) {
+        return false;
+    }
+    std::map<std::string, AppCounters> loaded;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string vehicleId;
+        AppCounters c;
+        if (!(fields >> vehicleId >> c.attackCounter >> c.normalPacketsSent >> c.attackPacketsSent
+                     >> c.packetsReceived >> c.attacksDetected >> c.packetsSent
+                     >> c.totalDetections >> c.highRateDetections >> c.packetsBlocked >> c.falsePositives)) {
+            return false;
+        }
+        loaded[vehicleId] = c;
+    }
+    vehicles.swap(loaded);
+    return true;
+}
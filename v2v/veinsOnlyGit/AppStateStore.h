@@ -0,0 +1,46 @@
+#ifndef APPSTATESTORE_H
+#define APPSTATESTORE_H
+
+#include <map>
+#include <string>
+
+// Application counters of every vehicle at the end of a warm-up run, keyed by
+// SUMO vehicle ID. A warm-started run loads SUMO's saved state and this file,
+// so each vehicle picks up where it left off.
+//
+// File format: a "# v2v-app-state 1" header, then one line per vehicle with
+// its ID followed by the counters in AppCounters order.
+
+namespace veins {
+
+struct AppCounters {
+    int attackCounter = 0;
+    int normalPacketsSent = 0;
+    int attackPacketsSent = 0;
+    int packetsReceived = 0;
+    int attacksDetected = 0;
+    int packetsSent = 0;
+    int totalDetections = 0;
+    int highRateDetections = 0;
+    int packetsBlocked = 0;
+    int falsePositives = 0;
+};
+
+class AppStateStore {
+public:
+    void put(const std::string& vehicleId, const AppCounters& counters) { vehicles[vehicleId] = counters; }
+    const AppCounters* find(const std::string& vehicleId) const;
+    size_t size() const { return vehicles.size(); }
+    bool empty() const { return vehicles.empty(); }
+    void clear() { vehicles.clear(); }
+
+    bool save(const std::string& fileName) const;
+    bool load(const std::string& fileName);        // False if unreadable or malformed
+
+private:
+    std::map<std::string, AppCounters> vehicles;
+};
+
+} // namespace veins
+
+#endif // APPSTATESTORE_H
@@ -0,0 +1,219 @@
+#include "veins/modules/application/traci/AttackModel.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+using namespace veins;
+
+namespace {
+
+std::map<std::string, AttackFactory>& registry() {
+    static std::map<std::string, AttackFactory> factories;
+    return factories;
+}
+
+// ==================== BUILT-IN MODELS ====================
+
+// Bursts of beacons with an implausible speed
+class FloodAttack : public AttackModel {
+public:
+    using AttackModel::AttackModel;
+    const char* getName() const override { return "flood"; }
+
+protected:
+    int defaultBurstSize() const override { return 5; }
+    void forge(const AttackerState&, int index, ForgedBeacon& beacon) override {
+        beacon.speedX = params.floodSpeed + index;
+        beacon.speedY = 0;
+    }
+};
+
+// A fixed, impossible position
+class SpoofAttack : public AttackModel {
+public:
+    using AttackModel::AttackModel;
+    const char* getName() const override { return "spoof"; }
+
+protected:
+    void forge(const AttackerState&, int, ForgedBeacon& beacon) override {
+        beacon.posX = params.spoofX;
+        beacon.posY = params.spoofY;
+        beacon.speedX = 0;
+        beacon.speedY = 0;
+    }
+};
+
+// An old position (and optionally send time) of the attacker, replayed
+class ReplayAttack : public AttackModel {
+public:
+    using AttackModel::AttackModel;
+    const char* getName() const override { return "replay"; }
+
+protected:
+    void forge(const AttackerState& self, int, ForgedBeacon& beacon) override {
+        beacon.posX = self.posX - params.replayOffset;
+        beacon.posY = self.posY - params.replayOffset;
+        beacon.speedX = params.replaySpeed;
+        beacon.speedY = 0;
+        beacon.timestamp = self.now - params.replayAge;
+    }
+};
+
+// One beacon per identity and tick, each a plausible ghost vehicle driving
+// in a row behind the attacker
+class SybilAttack : public AttackModel {
+public:
+    explicit SybilAttack(const AttackParams& params)
+        : AttackModel(params) {
+        if (params.identities < 2) {
+            throw std::invalid_argument("a sybil attack needs at least 2 identities");
+        }
+    }
+    const char* getName() const override { return "sybil"; }
+
+protected:
+    int defaultBurstSize() const override { return params.identities; }
+    void forge(const AttackerState& self, int index, ForgedBeacon& beacon) override {
+        double speed = std::hypot(self.speedX, self.speedY);
+        double dirX = speed > 0 ? self.speedX / speed : 1.0;
+        double dirY = speed > 0 ? self.speedY / speed : 0.0;
+        beacon.posX = self.posX - dirX * params.sybilSpacing * index;
+        beacon.posY = self.posY - dirY * params.sybilSpacing * index;
+    }
+};
+
+} // namespace
+
+Register_AttackModel(FloodAttack, "flood");
+Register_AttackModel(SpoofAttack, "spoof");
+Register_AttackModel(ReplayAttack, "replay");
+Register_AttackModel(SybilAttack, "sybil");
+
+// ==================== SCHEDULING AND IDENTITIES ====================
+
+AttackModel::RateProfile AttackModel::parseRateProfile(const std::string& name) {
+    if (name == "constant") {
+        return RateProfile::Constant;
+    } else if (name == "ramp") {
+        return RateProfile::Ramp;
+    } else if (name == "poisson") {
+        return RateProfile::Poisson;
+    }
+    throw std::invalid_argument("unknown attack rate profile '" + name + "'");
+}
+
+AttackModel::AttackModel(const AttackParams& params)
+    : params(params), rateProfile(parseRateProfile(params.rateProfile)) {
+    if (params.interval <= 0) {
+        throw std::invalid_argument("attack interval must be positive");
+    }
+    if (params.identities < 1 || params.identities > 999) {
+        throw std::invalid_argument("attack identities must lie in [1, 999]");
+    }
+    if (params.identities > 1 && params.firstForgedId <= 0) {
+        throw std::invalid_argument("forged identities need a positive first forged sender ID");
+    }
+    sent.resize(params.identities);
+}
+
+double AttackModel::nextTick(double now) {
+    if (startTime < 0) {
+        startTime = now;
+    }
+
+    double gap = params.interval;
+    if (rateProfile == RateProfile::Ramp) {
+        double progress = params.rampDuration > 0 ? std::min(1.0, (now - startTime) / params.rampDuration) : 1.0;
+        gap = params.interval / (1 + (params.rampFactor - 1) * progress);
+    } else if (rateProfile == RateProfile::Poisson) {
+        gap = std::exponential_distribution<double>(1 / params.interval)(rng);
+    }
+
+    // Ticks falling into an off period move to the start of the next on period
+    double next = now + gap;
+    if (params.onTime > 0 && params.offTime > 0) {
+        double period = params.onTime + params.offTime;
+        double phase = std::fmod(next - startTime, period);
+        if (phase >= params.onTime) {
+            next += period - phase;
+        }
+    }
+    return next - now;
+}
+
+void AttackModel::tick(const AttackerState& self, std::vector<ForgedBeacon>& out) {
+    int burst = params.burstSize > 0 ? params.burstSize : defaultBurstSize();
+    for (int index = 0; index < burst; index++) {
+        // Next identity in turn that still has evasion budget
+        int identity = -1;
+        for (int tries = 0; tries < params.identities && identity < 0; tries++) {
+            int candidate = nextIdentity;
+            nextIdentity = (nextIdentity + 1) % params.identities;
+            if (takeBudget(candidate, self.now)) {
+                identity = candidate;
+            }
+        }
+        if (identity < 0) {
+            return;                                // Every identity at the threshold
+        }
+
+        ForgedBeacon beacon;
+        beacon.srcId = identity == 0 ? self.ownId : forgedId(identity);
+        beacon.posX = self.posX;
+        beacon.posY = self.posY;
+        beacon.speedX = self.speedX;
+        beacon.speedY = self.speedY;
+        beacon.timestamp = self.now;
+        forge(self, index, beacon);
+        out.push_back(beacon);
+    }
+}
+
+void AttackModel::noteOwnBeacon(double now) {
+    if (params.evasion) {
+        sent[0].push_back(now);
+    }
+}
+
+bool AttackModel::takeBudget(int identity, double now) {
+    if (!params.evasion) {
+        return true;
+    }
+    std::deque<double>& times = sent[identity];
+    while (!times.empty() && times.front() < now - params.evasionWindow) {
+        times.pop_front();
+    }
+    if (times.size() >= size_t(std::floor(params.evasionThreshold * params.evasionMargin))) {
+        return false;
+    }
+    times.push_back(now);
+    return true;
+}
+
+std::vector<int> AttackModel::identityIds(int ownId) const {
+    std::vector<int> ids(1, ownId);
+    for (int k = 1; k < params.identities; k++) {
+        ids.push_back(forgedId(k));
+    }
+    return ids;
+}
+
+// ==================== REGISTRY ====================
+
+void AttackModelRegistry::add(const std::string& name, AttackFactory factory) {
+    registry()[name] = factory;
+}
+
+std::unique_ptr<AttackModel> AttackModelRegistry::create(const std::string& name, const AttackParams& params) {
+    auto it = registry().find(name);
+    return it == registry().end() ? nullptr : it->second(params);
+}
+
+std::vector<std::string> AttackModelRegistry::getNames() {
+    std::vector<std::string> names;
+    for (const auto& entry : registry()) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
@@ -0,0 +1,155 @@
+#ifndef ATTACKMODEL_H
+#define ATTACKMODEL_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Attacker behaviour for malicious MyVeinsApp nodes. An attack model is a
+// registered class, chosen by name (attackType) once at initialize; on every
+// attack timer tick it forges a burst of beacons, and it decides when the
+// next tick is. What all models share is handled here:
+//
+//  Rate profile  - "constant" ticks every interval, "ramp" shortens the
+//                  interval down to interval/rampFactor over rampDuration,
+//                  "poisson" draws exponential gaps with mean interval
+//  On/off        - attack for onTime, pause for offTime, repeat
+//  Identities    - bursts rotate over this many sender IDs, the node's own
+//                  first and then forged ones, consecutive from firstForgedId;
+//                  the caller hands out these blocks so that all forged IDs
+//                  of a run form one compact range
+//  Evasion       - per identity, never exceed evasionMargin * evasionThreshold
+//                  messages in evasionWindow, i.e. stay just below the flood
+//                  threshold of the receivers' detectors
+//
+// The models themselves only fill in the payload of each forged beacon.
+// Like the detector core, this is free of OMNeT++; times are seconds.
+
+namespace veins {
+
+struct AttackParams {
+    double interval = 2.0;                         // Mean time between ticks (s)
+    int burstSize = 0;                             // Beacons per tick, 0 for the model's default
+    std::string rateProfile = "constant";          // "constant", "ramp" or "poisson"
+    double rampDuration = 30.0;                    // s
+    double rampFactor = 10.0;                      // Final rate / initial rate
+    double onTime = 0.0;                           // s; 0 attacks continuously
+    double offTime = 0.0;                          // s
+    int identities = 1;                            // Sender IDs the bursts rotate over
+    int firstForgedId = 0;                         // Sender ID of forged identity 1, the others follow
+    bool evasion = false;
+    double evasionThreshold = 50.0;                // Messages per window the receivers tolerate
+    double evasionWindow = 3.0;                    // s
+    double evasionMargin = 0.9;
+
+    double floodSpeed = 150.0;                     // flood: claimed speed (m/s), +1 per beacon of a burst
+    double spoofX = 7000.0;                        // spoof: claimed position
+    double spoofY = 7000.0;
+    double replayOffset = 500.0;                   // replay: claimed position behind the real one (m)
+    double replaySpeed = 100.0;                    // replay: claimed speed (m/s)
+    double replayAge = 0.0;                        // replay: claimed send time this far in the past (s)
+    double sybilSpacing = 10.0;                    // sybil: gap between the ghost vehicles (m)
+};
+
+// The attacking node at the time of a tick
+struct AttackerState {
+    int ownId = -1;
+    double now = 0.0;
+    double posX = 0.0;
+    double posY = 0.0;
+    double speedX = 0.0;
+    double speedY = 0.0;
+};
+
+struct ForgedBeacon {
+    int srcId = -1;
+    double posX = 0.0;
+    double posY = 0.0;
+    double speedX = 0.0;
+    double speedY = 0.0;
+    double timestamp = 0.0;                        // Claimed send time
+};
+
+class AttackModel {
+public:
+    explicit AttackModel(const AttackParams& params);
+    virtual ~AttackModel() = default;
+
+    virtual const char* getName() const = 0;
+    const AttackParams& getParams() const { return params; }
+
+    void seed(uint32_t seed) { rng.seed(seed); }
+
+    // Delay from now to the next tick, following the rate profile and the
+    // on/off pattern. The first call starts the attack clock.
+    double nextTick(double now);
+
+    // Appends this tick's forged beacons to out
+    void tick(const AttackerState& self, std::vector<ForgedBeacon>& out);
+
+    // Legitimate beacons under the own ID count against the evasion budget
+    void noteOwnBeacon(double now);
+
+    // Sender IDs this attacker uses (own ID first), for the ground truth
+    std::vector<int> identityIds(int ownId) const;
+
+    // Forged sender ID k (k >= 1)
+    int forgedId(int k) const { return params.firstForgedId + k - 1; }
+
+protected:
+    // Beacons per tick when burstSize is 0
+    virtual int defaultBurstSize() const { return 1; }
+
+    // Fills in the claimed kinematics and send time of beacon index of a burst
+    virtual void forge(const AttackerState& self, int index, ForgedBeacon& beacon) = 0;
+
+    const AttackParams params;
+    std::mt19937 rng;
+
+private:
+    enum class RateProfile {
+        Constant,
+        Ramp,
+        Poisson
+    };
+
+    static RateProfile parseRateProfile(const std::string& name);
+    bool takeBudget(int identity, double now);
+
+    RateProfile rateProfile;
+    double startTime = -1;
+    int nextIdentity = 0;
+    std::vector<std::deque<double>> sent;          // Per identity, send times within evasionWindow
+};
+
+using AttackFactory = std::unique_ptr<AttackModel> (*)(const AttackParams& params);
+
+// Attack models by attackType name
+class AttackModelRegistry {
+public:
+    static void add(const std::string& name, AttackFactory factory);
+
+    // nullptr for an unknown name
+    static std::unique_ptr<AttackModel> create(const std::string& name, const AttackParams& params);
+
+    static std::vector<std::string> getNames();
+};
+
+struct AttackModelRegistrar {
+    AttackModelRegistrar(const char* name, AttackFactory factory) { AttackModelRegistry::add(name, factory); }
+};
+
+} // namespace veins
+
+#define V2V_ATTACK_CONCAT2(a, b) a##b
+#define V2V_ATTACK_CONCAT(a, b) V2V_ATTACK_CONCAT2(a, b)
+
+// Registers CLASS (constructible from AttackParams) as attackType NAME
+#define Register_AttackModel(CLASS, NAME) \
+    static ::veins::AttackModelRegistrar V2V_ATTACK_CONCAT(attackModelRegistrar, __LINE__)(NAME, \
+            [](const ::veins::AttackParams& p) -> std::unique_ptr<::veins::AttackModel> { return std::unique_ptr<::veins::AttackModel>(new CLASS(p)); })
+
+#endif // ATTACKMODEL_H
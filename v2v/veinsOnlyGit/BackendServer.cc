@@ -0,0 +1,90 @@
+#include "veins/modules/application/traci/BackendServer.h"
+#include "veins/modules/application/traci/RelayBatch.h"
+#include "veins/modules/messages/BackhaulBatch_m.h"
+#include <cmath>
+
+using namespace veins;
+
+Define_Module(veins::BackendServer);
+
+void BackendServer::initialize() {
+    validateContent = par("validateContent");
+    contentParams.maxReasonableSpeed = par("maxReasonableSpeed");
+    contentParams.maxMessageAge = par("maxMessageAge");
+    batchDelayHistogram.setName("backendBatchDelay");
+    messageAgeHistogram.setName("backendMessageAge");
+}
+
+void BackendServer::handleMessage(cMessage* msg) {
+    BackhaulBatch* batch = check_and_cast<BackhaulBatch*>(msg);
+
+    std::vector<uint8_t> payload(batch->getPayloadArraySize());
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = batch->getPayload(i);
+    }
+
+    std::vector<RelayRecord> records;
+    if (!decodeRelayRecords(payload, records) || (int)records.size() != batch->getRecordCount()) {
+        EV_WARN << "Malformed relay batch from RSU " << batch->getRsuId() << endl;
+        batchesMalformed++;
+        delete msg;
+        return;
+    }
+
+    batchesReceived++;
+    recordsReceived += records.size();
+    bytesReceived += batch->getByteLength();
+    rawBytesReceived += batch->getRawBytes();
+    recordsPerRsu[batch->getRsuId()] += records.size();
+
+    batchDelayHistogram.collect(simTime() - batch->getOldestReception());
+    for (const RelayRecord& record : records) {
+        if (record.timestamp > 0 && std::isfinite(record.timestamp)) {
+            messageAgeHistogram.collect(simTime().dbl() - record.timestamp);
+        }
+    }
+
+    if (validateContent) {
+        double now = simTime().dbl();
+        contentBatch.clear();
+        for (const RelayRecord& record : records) {
+            // No claimed send time (0) is not held against the message
+            double sent = record.timestamp > 0 ? record.timestamp : now;
+            contentBatch.add(record.posX, record.posY, record.speedX, record.speedY, sent, now);
+        }
+        contentChecks.resize(records.size());
+        size_t valid = validateBatch(contentBatch, contentParams, contentChecks.data());
+        if (valid < records.size()) {
+            for (size_t i = 0; i < records.size(); i++) {
+                if (contentChecks[i] != uint8_t(ContentCheck::Valid)) {
+                    invalidRecords[contentChecks[i]]++;
+                    EV_DEBUG << "Relayed message " << records[i].packetId << " from vehicle " << records[i].senderId
+                             << " failed content check: " << contentCheckName(ContentCheck(contentChecks[i])) << endl;
+                }
+            }
+        }
+    }
+
+    EV_DEBUG << "Backend received " << records.size() << " relayed messages from RSU " << batch->getRsuId()
+             << " | " << batch->getByteLength() << " bytes" << endl;
+    delete msg;
+}
+
+void BackendServer::finish() {
+    recordScalar("backendBatchesReceived", batchesReceived);
+    recordScalar("backendBatchesMalformed", batchesMalformed);
+    recordScalar("backendMessagesReceived", recordsReceived);
+    recordScalar("backendBytesReceived", bytesReceived);
+    if (validateContent) {
+        recordScalar("backendInvalidPosition", invalidRecords[int(ContentCheck::InvalidPosition)]);
+        recordScalar("backendUnreasonableSpeed", invalidRecords[int(ContentCheck::UnreasonableSpeed)]);
+        recordScalar("backendFutureTimestamp", invalidRecords[int(ContentCheck::FutureTimestamp)]);
+        recordScalar("backendStaleMessage", invalidRecords[int(ContentCheck::StaleMessage)]);
+    }
+    recordScalar("backendCompressionRatio", bytesReceived > 0 ? (double)rawBytesReceived / bytesReceived : 0);
+    for (const auto& entry : recordsPerRsu) {
+        EV_INFO << "Backend: " << entry.second << " messages via RSU " << entry.first << endl;
+    }
+    recordStatistic(&batchDelayHistogram, "s");
+    recordStatistic(&messageAgeHistogram, "s");
+}
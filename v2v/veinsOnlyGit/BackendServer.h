@@ -0,0 +1,43 @@
+#ifndef BACKENDSERVER_H
+#define BACKENDSERVER_H
+
+#include <map>
+#include <vector>
+#include <omnetpp.h>
+#include "veins/veins.h"
+#include "veins/modules/application/traci/BeaconBatch.h"
+
+using namespace omnetpp;
+
+namespace veins {
+
+// Receives relay batches from the RSUs, decodes them and records what
+// arrived and how long the relayed messages took to get here. The content of
+// the relayed messages is checked a whole batch at a time (BeaconBatch).
+class BackendServer : public cSimpleModule {
+protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage* msg) override;
+    virtual void finish() override;
+
+private:
+    bool validateContent = true;
+    DetectorParams contentParams;                  // Speed and age limits only
+    BeaconBatch contentBatch;                      // Reused across batches
+    std::vector<uint8_t> contentChecks;
+    long invalidRecords[5] = {};                   // Per ContentCheck
+
+    long batchesReceived = 0;
+    long batchesMalformed = 0;
+    long recordsReceived = 0;
+    long bytesReceived = 0;                        // On the wire
+    long rawBytesReceived = 0;                     // Relayed frame sizes
+    std::map<int, long> recordsPerRsu;
+
+    cHistogram batchDelayHistogram;                // First reception at the RSU -> backend
+    cHistogram messageAgeHistogram;                // Vehicle send time -> backend
+};
+
+} // namespace veins
+
+#endif // BACKENDSERVER_H
@@ -0,0 +1,174 @@
+#include "veins/modules/application/traci/BeaconBatch.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace veins;
+
+namespace {
+
+// ContentCheck of the first failing check, indexed by the failed checks
+// (bit 0 position, 1 speed, 2 future timestamp, 3 stale)
+const uint8_t firstFailure[16] = {
+    uint8_t(ContentCheck::Valid),
+    uint8_t(ContentCheck::InvalidPosition), uint8_t(ContentCheck::UnreasonableSpeed), uint8_t(ContentCheck::InvalidPosition),
+    uint8_t(ContentCheck::FutureTimestamp), uint8_t(ContentCheck::InvalidPosition), uint8_t(ContentCheck::UnreasonableSpeed), uint8_t(ContentCheck::InvalidPosition),
+    uint8_t(ContentCheck::StaleMessage), uint8_t(ContentCheck::InvalidPosition), uint8_t(ContentCheck::UnreasonableSpeed), uint8_t(ContentCheck::InvalidPosition),
+    uint8_t(ContentCheck::FutureTimestamp), uint8_t(ContentCheck::InvalidPosition), uint8_t(ContentCheck::UnreasonableSpeed), uint8_t(ContentCheck::InvalidPosition)
+};
+
+// Compared against the squared speed; a negative limit rejects every speed
+double speedLimitSquared(const DetectorParams& params) {
+    return params.maxReasonableSpeed >= 0 ? params.maxReasonableSpeed * params.maxReasonableSpeed : -1;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define V2V_BEACON_BATCH_AVX
+// Compiled for AVX regardless of the build flags, only called when the CPU has it
+__attribute__((target("avx"))) size_t validateAvx(const BeaconBatch& batch, double limit, double maxAge, uint8_t* checks, size_t& done) {
+    const __m256d limitV = _mm256_set1_pd(limit);
+    const __m256d maxAgeV = _mm256_set1_pd(maxAge);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d invalidPosition = _mm256_set1_pd(double(ContentCheck::InvalidPosition));
+    const __m256d unreasonableSpeed = _mm256_set1_pd(double(ContentCheck::UnreasonableSpeed));
+    const __m256d futureTimestamp = _mm256_set1_pd(double(ContentCheck::FutureTimestamp));
+    const __m256d staleMessage = _mm256_set1_pd(double(ContentCheck::StaleMessage));
+    size_t failed = 0;
+    size_t i = 0;
+    for (; i + 4 <= batch.size(); i += 4) {
+        __m256d x = _mm256_load_pd(batch.posX.data() + i);
+        __m256d y = _mm256_load_pd(batch.posY.data() + i);
+        __m256d vx = _mm256_load_pd(batch.speedX.data() + i);
+        __m256d vy = _mm256_load_pd(batch.speedY.data() + i);
+        __m256d sent = _mm256_load_pd(batch.timestamp.data() + i);
+        __m256d received = _mm256_load_pd(batch.time.data() + i);
+
+        // x - x is 0 for finite x and NaN for NaN and inf
+        __m256d finite = _mm256_and_pd(_mm256_cmp_pd(_mm256_sub_pd(x, x), zero, _CMP_EQ_OQ),
+                _mm256_cmp_pd(_mm256_sub_pd(y, y), zero, _CMP_EQ_OQ));
+        __m256d speed2 = _mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy));
+
+        // Last check first, so the first failing one wins
+        __m256d code = _mm256_and_pd(_mm256_cmp_pd(_mm256_sub_pd(received, sent), maxAgeV, _CMP_GT_OQ), staleMessage);
+        code = _mm256_blendv_pd(code, futureTimestamp, _mm256_cmp_pd(sent, received, _CMP_GT_OQ));
+        code = _mm256_blendv_pd(code, unreasonableSpeed, _mm256_cmp_pd(speed2, limitV, _CMP_GT_OQ));
+        code = _mm256_blendv_pd(invalidPosition, code, finite);
+
+        __m128i codes = _mm256_cvttpd_epi32(code);
+        codes = _mm_packus_epi16(_mm_packs_epi32(codes, codes), codes);
+        int packed = _mm_cvtsi128_si32(codes);
+        std::memcpy(checks + i, &packed, 4);
+        failed += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(code, zero, _CMP_NEQ_OQ)));
+    }
+    done = i;
+    return i - failed;
+}
+#endif
+
+#ifdef __SSE2__
+// SSE2 has no blendv
+inline __m128d select(__m128d mask, __m128d ifTrue, __m128d ifFalse) {
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+size_t validateSse2(const BeaconBatch& batch, double limit, double maxAge, uint8_t* checks, size_t& done) {
+    const __m128d limitV = _mm_set1_pd(limit);
+    const __m128d maxAgeV = _mm_set1_pd(maxAge);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d invalidPosition = _mm_set1_pd(double(ContentCheck::InvalidPosition));
+    const __m128d unreasonableSpeed = _mm_set1_pd(double(ContentCheck::UnreasonableSpeed));
+    const __m128d futureTimestamp = _mm_set1_pd(double(ContentCheck::FutureTimestamp));
+    const __m128d staleMessage = _mm_set1_pd(double(ContentCheck::StaleMessage));
+    size_t failed = 0;
+    size_t i = 0;
+    for (; i + 2 <= batch.size(); i += 2) {
+        __m128d x = _mm_load_pd(batch.posX.data() + i);
+        __m128d y = _mm_load_pd(batch.posY.data() + i);
+        __m128d vx = _mm_load_pd(batch.speedX.data() + i);
+        __m128d vy = _mm_load_pd(batch.speedY.data() + i);
+        __m128d sent = _mm_load_pd(batch.timestamp.data() + i);
+        __m128d received = _mm_load_pd(batch.time.data() + i);
+
+        __m128d finite = _mm_and_pd(_mm_cmpeq_pd(_mm_sub_pd(x, x), zero), _mm_cmpeq_pd(_mm_sub_pd(y, y), zero));
+        __m128d speed2 = _mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy));
+
+        __m128d code = _mm_and_pd(_mm_cmpgt_pd(_mm_sub_pd(received, sent), maxAgeV), staleMessage);
+        code = select(_mm_cmpgt_pd(sent, received), futureTimestamp, code);
+        code = select(_mm_cmpgt_pd(speed2, limitV), unreasonableSpeed, code);
+        code = select(finite, code, invalidPosition);
+
+        __m128i codes = _mm_cvttpd_epi32(code);
+        codes = _mm_packus_epi16(_mm_packs_epi32(codes, codes), codes);
+        int packed = _mm_cvtsi128_si32(codes);
+        checks[i] = uint8_t(packed);
+        checks[i + 1] = uint8_t(packed >> 8);
+        failed += __builtin_popcount(_mm_movemask_pd(_mm_cmpneq_pd(code, zero)));
+    }
+    done = i;
+    return i - failed;
+}
+#endif
+
+} // namespace
+
+void BeaconBatch::assign(const ReceptionEvent* events, size_t n) {
+    for (Column* column : {&posX, &posY, &speedX, &speedY, &timestamp, &time}) {
+        column->resize(n);
+    }
+    for (size_t i = 0; i < n; i++) {
+        posX[i] = events[i].posX;
+        posY[i] = events[i].posY;
+        speedX[i] = events[i].speedX;
+        speedY[i] = events[i].speedY;
+        timestamp[i] = events[i].timestamp;
+        time[i] = events[i].time;
+    }
+}
+
+void BeaconBatch::reserve(size_t n) {
+    for (Column* column : {&posX, &posY, &speedX, &speedY, &timestamp, &time}) {
+        column->reserve(n);
+    }
+}
+
+void BeaconBatch::clear() {
+    for (Column* column : {&posX, &posY, &speedX, &speedY, &timestamp, &time}) {
+        column->clear();
+    }
+}
+
+size_t veins::validateBatchScalar(const BeaconBatch& batch, const DetectorParams& params, uint8_t* checks, size_t first) {
+    double limit = speedLimitSquared(params);
+    size_t valid = 0;
+    for (size_t i = first; i < batch.size(); i++) {
+        double x = batch.posX[i];
+        double y = batch.posY[i];
+        int failed = !(x - x == 0) || !(y - y == 0);
+        failed |= (batch.speedX[i] * batch.speedX[i] + batch.speedY[i] * batch.speedY[i] > limit) << 1;
+        failed |= (batch.timestamp[i] > batch.time[i]) << 2;
+        failed |= (batch.time[i] - batch.timestamp[i] > params.maxMessageAge) << 3;
+        checks[i] = firstFailure[failed];
+        valid += failed == 0;
+    }
+    return valid;
+}
+
+size_t veins::validateBatch(const BeaconBatch& batch, const DetectorParams& params, uint8_t* checks) {
+    double limit = speedLimitSquared(params);
+    size_t done = 0;
+    size_t valid = 0;
+#ifdef V2V_BEACON_BATCH_AVX
+    static const bool hasAvx = __builtin_cpu_supports("avx");
+    if (hasAvx) {
+        valid = validateAvx(batch, limit, params.maxMessageAge, checks, done);
+    } else
+#endif
+    {
+#ifdef __SSE2__
+        valid = validateSse2(batch, limit, params.maxMessageAge, checks, done);
+#endif
+    }
+    return valid + validateBatchScalar(batch, params, checks, done);
+}
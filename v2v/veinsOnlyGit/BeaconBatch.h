@@ -0,0 +1,93 @@
+#ifndef BEACONBATCH_H
+#define BEACONBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+// Received beacons gathered field by field (structure of arrays) so the
+// content checks of SecurityDetector::validateMessageContent can run over a
+// whole batch with SIMD: finite position, squared speed against the squared
+// limit (no sqrt), future and stale timestamps. Arrays are 32 byte aligned for
+// AVX loads.
+
+namespace veins {
+
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        // aligned_alloc wants a multiple of the alignment
+        size_t bytes = (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        void* p = std::aligned_alloc(Alignment, bytes);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t) { std::free(p); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+class BeaconBatch {
+public:
+    using Column = std::vector<double, AlignedAllocator<double, 32>>;
+
+    void add(const ReceptionEvent& ev) {
+        add(ev.posX, ev.posY, ev.speedX, ev.speedY, ev.timestamp, ev.time);
+    }
+    void add(double x, double y, double vx, double vy, double sent, double received) {
+        posX.push_back(x);
+        posY.push_back(y);
+        speedX.push_back(vx);
+        speedY.push_back(vy);
+        timestamp.push_back(sent);
+        time.push_back(received);
+    }
+
+    // Replaces the batch with events[0..n) in a single pass over the events
+    void assign(const ReceptionEvent* events, size_t n);
+
+    void reserve(size_t n);
+    void clear();
+    size_t size() const { return time.size(); }
+
+    Column posX;                                   // Claimed position
+    Column posY;
+    Column speedX;                                 // Claimed speed
+    Column speedY;
+    Column timestamp;                              // Claimed send time
+    Column time;                                   // Reception time
+};
+
+// Writes the ContentCheck of every beacon into checks[0..size) (0 is Valid,
+// so the array doubles as a validity mask) and returns the number of valid
+// beacons. Same result as validateMessageContent per beacon, except that a
+// speed within one rounding step of maxReasonableSpeed may land on the other
+// side of the limit.
+size_t validateBatch(const BeaconBatch& batch, const DetectorParams& params, uint8_t* checks);
+
+// Scalar reference of validateBatch, used on targets without SSE2 and for the
+// tail of a batch
+size_t validateBatchScalar(const BeaconBatch& batch, const DetectorParams& params, uint8_t* checks, size_t first = 0);
+
+} // namespace veins
+
+#endif // BEACONBATCH_H
@@ -0,0 +1,71 @@
+#include "veins/modules/application/traci/ColumnarOutputVectorManager.h"
+#include <cstdio>
+
+using namespace veins;
+
+Register_Class(veins::ColumnarOutputVectorManager);
+
+Register_PerRunConfigOption(CFGID_COLUMNAR_VECTOR_FILE, "columnar-vector-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.vecc", "Output file of veins::ColumnarOutputVectorManager.");
+
+ColumnarOutputVectorManager::~ColumnarOutputVectorManager() {
+    writer.close();
+}
+
+void ColumnarOutputVectorManager::startRun() {
+    writer.close();
+    fileName = getEnvir()->getConfig()->getAsFilename(CFGID_COLUMNAR_VECTOR_FILE);
+    fileFailed = false;
+    // The file is created on the first recorded sample, like the text .vec file
+    std::remove(fileName.c_str());
+}
+
+void ColumnarOutputVectorManager::endRun() {
+    if (writer.isOpen() && !writer.close()) {
+        throw cRuntimeError("Cannot write output vector file '%s'", fileName.c_str());
+    }
+}
+
+void* ColumnarOutputVectorManager::registerVector(const char* modulename, const char* vectorname, opp_string_map* attributes) {
+    Vector* vector = new Vector();
+    vector->module = modulename;
+    vector->name = vectorname;
+    if (attributes) {
+        vector->attributes.insert(attributes->begin(), attributes->end());
+    }
+    std::string objectFullPath = vector->module + "." + vector->name;
+    vector->enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), cConfigOption::get("vector-recording"), true);
+    return vector;
+}
+
+void ColumnarOutputVectorManager::deregisterVector(void* vechandle) {
+    delete static_cast<Vector*>(vechandle);
+}
+
+bool ColumnarOutputVectorManager::record(void* vechandle, simtime_t t, double value) {
+    Vector* vector = static_cast<Vector*>(vechandle);
+    if (!vector->enabled) {
+        return false;
+    }
+    if (!writer.isOpen()) {
+        openFile();
+    }
+    if (vector->column < 0) {
+        vector->column = writer.addVector(vector->module, vector->name, vector->attributes);
+    }
+    writer.append(vector->column, getSimulation()->getEventNumber(), t.raw(), value);
+    return true;
+}
+
+void ColumnarOutputVectorManager::flush() {
+    writer.flush();
+}
+
+void ColumnarOutputVectorManager::openFile() {
+    if (fileFailed) {
+        return;
+    }
+    if (!writer.open(fileName, SimTime::getScaleExp())) {
+        fileFailed = true;
+        throw cRuntimeError("Cannot open output vector file '%s'", fileName.c_str());
+    }
+}
@@ -0,0 +1,323 @@
+#include "veins/modules/application/traci/ColumnarVectorFile.h"
+#include "veins/modules/application/traci/Varint.h"
+#include <cmath>
+#include <cstring>
+
+using namespace veins;
+
+namespace {
+
+const char fileMagic[8] = {'V', '2', 'V', 'C', 'O', 'L', 'V', 'C'};
+const size_t headerSize = 16;                      // Magic, version, simtime scale exponent
+const size_t trailerSize = 16;                     // Footer offset, magic
+
+// The file is little-endian; on such hosts value columns are copied as is
+constexpr bool hostLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+void putFixed(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.push_back(uint8_t(value >> (8 * i)));
+    }
+}
+
+uint64_t getFixed(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= uint64_t(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+void putString(std::vector<uint8_t>& out, const std::string& text) {
+    putVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+bool getString(const std::vector<uint8_t>& in, size_t& pos, std::string& text) {
+    uint64_t size;
+    if (!getVarint(in, pos, size) || size > in.size() - pos) {
+        return false;
+    }
+    text.assign((const char*)in.data() + pos, size);
+    pos += size;
+    return true;
+}
+
+} // namespace
+
+ColumnarVectorWriter::~ColumnarVectorWriter() {
+    close();
+}
+
+bool ColumnarVectorWriter::open(const std::string& fileName, int timeScaleExp) {
+    close();
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    scratch.assign(fileMagic, fileMagic + sizeof(fileMagic));
+    putFixed(scratch, version, 4);
+    putFixed(scratch, uint32_t(timeScaleExp), 4);
+    offset = 0;
+    write(scratch.data(), scratch.size());
+
+    columns.clear();
+    samplesWritten = 0;
+    return true;
+}
+
+bool ColumnarVectorWriter::close() {
+    if (!file) {
+        return true;
+    }
+    flush();
+
+    // Directory of all vectors, then the trailer pointing at it
+    uint64_t footerOffset = offset;
+    scratch.clear();
+    putVarint(scratch, columns.size());
+    for (const Column& column : columns) {
+        putString(scratch, column.module);
+        putString(scratch, column.name);
+        putVarint(scratch, column.attributes.size());
+        for (const auto& attribute : column.attributes) {
+            putString(scratch, attribute.first);
+            putString(scratch, attribute.second);
+        }
+        putVarint(scratch, column.count);
+        putVarint(scratch, column.blockOffsets.size());
+        uint64_t previous = 0;
+        for (uint64_t blockOffset : column.blockOffsets) {
+            putVarint(scratch, blockOffset - previous);
+            previous = blockOffset;
+        }
+    }
+    putFixed(scratch, footerOffset, 8);
+    scratch.insert(scratch.end(), fileMagic, fileMagic + sizeof(fileMagic));
+    write(scratch.data(), scratch.size());
+
+    bool ok = !std::ferror(file);
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    columns.clear();
+    return ok;
+}
+
+int ColumnarVectorWriter::addVector(const std::string& module, const std::string& name, const VectorAttributes& attributes) {
+    Column column;
+    column.module = module;
+    column.name = name;
+    column.attributes = attributes;
+    columns.push_back(std::move(column));
+    return int(columns.size()) - 1;
+}
+
+void ColumnarVectorWriter::append(int vector, int64_t eventNumber, int64_t rawTime, double value) {
+    if (!file) {
+        return;
+    }
+    Column& column = columns[vector];
+    if (column.values.empty()) {
+        column.events.reserve(blockSize);
+        column.times.reserve(blockSize);
+        column.values.reserve(blockSize);
+    }
+    column.events.push_back(eventNumber);
+    column.times.push_back(rawTime);
+    column.values.push_back(value);
+    if (column.values.size() >= blockSize) {
+        writeBlock(vector);
+    }
+}
+
+void ColumnarVectorWriter::flush() {
+    if (!file) {
+        return;
+    }
+    for (size_t i = 0; i < columns.size(); i++) {
+        writeBlock(int(i));
+    }
+    std::fflush(file);
+}
+
+void ColumnarVectorWriter::writeBlock(int vector) {
+    Column& column = columns[vector];
+    size_t count = column.values.size();
+    if (count == 0) {
+        return;
+    }
+
+    scratch.clear();
+    putVarint(scratch, vector);
+    putVarint(scratch, count);
+    int64_t previous = 0;
+    for (int64_t event : column.events) {
+        putVarint(scratch, zigzag(event - previous));
+        previous = event;
+    }
+    previous = 0;
+    for (int64_t time : column.times) {
+        putVarint(scratch, zigzag(time - previous));
+        previous = time;
+    }
+
+    column.blockOffsets.push_back(offset);
+    if (hostLittleEndian) {
+        write(scratch.data(), scratch.size());
+        write(column.values.data(), count * sizeof(double));
+    } else {
+        for (double value : column.values) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            putFixed(scratch, bits, 8);
+        }
+        write(scratch.data(), scratch.size());
+    }
+
+    column.count += count;
+    samplesWritten += count;
+    column.events.clear();
+    column.times.clear();
+    column.values.clear();
+}
+
+void ColumnarVectorWriter::write(const void* data, size_t size) {
+    std::fwrite(data, 1, size, file);
+    offset += size;
+}
+
+bool ColumnarVectorReader::open(const std::string& fileName, std::string& error) {
+    vectors.clear();
+    content.clear();
+
+    std::FILE* file = std::fopen(fileName.c_str(), "rb");
+    if (!file) {
+        error = "cannot open " + fileName;
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (size > 0) {
+        content.resize(size);
+        if (std::fread(content.data(), 1, size, file) != size_t(size)) {
+            content.clear();
+        }
+    }
+    std::fclose(file);
+
+    if (content.size() < headerSize + trailerSize || std::memcmp(content.data(), fileMagic, sizeof(fileMagic)) != 0) {
+        error = fileName + " is not a columnar vector file";
+        return false;
+    }
+    uint32_t fileVersion = uint32_t(getFixed(content.data() + 8, 4));
+    int32_t timeScaleExp = int32_t(uint32_t(getFixed(content.data() + 12, 4)));
+    const uint8_t* trailer = content.data() + content.size() - trailerSize;
+    uint64_t footerOffset = getFixed(trailer, 8);
+    if (fileVersion != ColumnarVectorWriter::version) {
+        error = fileName + ": unsupported version " + std::to_string(fileVersion);
+        return false;
+    }
+    if (std::memcmp(trailer + 8, fileMagic, sizeof(fileMagic)) != 0 || footerOffset > content.size() - trailerSize) {
+        error = fileName + " is truncated (the run did not finish?)";
+        return false;
+    }
+    timeScale = std::pow(10.0, timeScaleExp);
+
+    size_t pos = footerOffset;
+    uint64_t vectorCount;
+    bool ok = getVarint(content, pos, vectorCount);
+    for (uint64_t i = 0; ok && i < vectorCount; i++) {
+        ColumnarVectorInfo info;
+        uint64_t attributeCount, blockCount;
+        ok = getString(content, pos, info.module) && getString(content, pos, info.name) && getVarint(content, pos, attributeCount);
+        for (uint64_t a = 0; ok && a < attributeCount; a++) {
+            std::string key, value;
+            ok = getString(content, pos, key) && getString(content, pos, value);
+            info.attributes[key] = value;
+        }
+        ok = ok && getVarint(content, pos, info.count) && getVarint(content, pos, blockCount);
+        uint64_t blockOffset = 0;
+        for (uint64_t b = 0; ok && b < blockCount; b++) {
+            uint64_t gap;
+            ok = getVarint(content, pos, gap);
+            blockOffset += gap;
+            info.blockOffsets.push_back(blockOffset);
+        }
+        vectors.push_back(std::move(info));
+    }
+    if (!ok) {
+        error = fileName + ": corrupt vector directory";
+        vectors.clear();
+        return false;
+    }
+    return true;
+}
+
+int ColumnarVectorReader::find(const std::string& module, const std::string& name) const {
+    for (size_t i = 0; i < vectors.size(); i++) {
+        if (vectors[i].module == module && vectors[i].name == name) {
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+bool ColumnarVectorReader::load(int vector, ColumnarVectorData& data, std::string& error) const {
+    const ColumnarVectorInfo& info = vectors.at(vector);
+    data.events.clear();
+    data.times.clear();
+    data.values.clear();
+    data.events.reserve(info.count);
+    data.times.reserve(info.count);
+    data.values.resize(info.count);
+
+    size_t loaded = 0;
+    for (uint64_t blockOffset : info.blockOffsets) {
+        size_t pos = blockOffset;
+        uint64_t blockVector, count;
+        if (!getVarint(content, pos, blockVector) || !getVarint(content, pos, count) || blockVector != uint64_t(vector) || count > info.count - loaded) {
+            error = "corrupt block of vector " + info.module + " " + info.name;
+            return false;
+        }
+        int64_t previous = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t delta;
+            if (!getVarint(content, pos, delta)) {
+                error = "corrupt event column of vector " + info.module + " " + info.name;
+                return false;
+            }
+            previous += unzigzag(delta);
+            data.events.push_back(previous);
+        }
+        previous = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t delta;
+            if (!getVarint(content, pos, delta)) {
+                error = "corrupt time column of vector " + info.module + " " + info.name;
+                return false;
+            }
+            previous += unzigzag(delta);
+            data.times.push_back(previous * timeScale);
+        }
+        if (count * sizeof(double) > content.size() - pos) {
+            error = "corrupt value column of vector " + info.module + " " + info.name;
+            return false;
+        }
+        if (hostLittleEndian) {
+            std::memcpy(data.values.data() + loaded, content.data() + pos, count * sizeof(double));
+        } else {
+            for (uint64_t i = 0; i < count; i++) {
+                uint64_t bits = getFixed(content.data() + pos + 8 * i, 8);
+                std::memcpy(&data.values[loaded + i], &bits, sizeof(double));
+            }
+        }
+        loaded += count;
+    }
+    if (loaded != info.count) {
+        error = "missing blocks of vector " + info.module + " " + info.name;
+        return false;
+    }
+    return true;
+}
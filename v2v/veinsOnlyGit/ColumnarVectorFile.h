@@ -0,0 +1,98 @@
+#ifndef COLUMNARVECTORFILE_H
+#define COLUMNARVECTORFILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// Columnar binary layout for output vectors, written by
+// ColumnarOutputVectorManager and read back by tools/columnar_vectors.
+//
+// A 16 byte header ("V2VCOLVC", version, simtime scale exponent) is followed
+// by blocks of up to blockSize samples of one vector each. A block stores its
+// columns one after the other: varint event number deltas, zigzag varint raw
+// simtime deltas, then the values as doubles. The footer lists every vector
+// (module, name, attributes, sample count, block offsets) and ends with its
+// own offset and the magic, so a reader loads the directory first and
+// decodes only the vectors it asks for. Fixed-size fields and values are
+// little-endian on any host; big-endian hosts swap them.
+
+namespace veins {
+
+using VectorAttributes = std::map<std::string, std::string>;
+
+class ColumnarVectorWriter {
+public:
+    static const uint32_t version = 1;
+    static const size_t blockSize = 4096;          // Samples buffered per vector
+
+    ~ColumnarVectorWriter();
+
+    // timeScaleExp: simulation time resolution, raw times are in 10^exp s
+    bool open(const std::string& fileName, int timeScaleExp);
+    bool close();
+    bool isOpen() const { return file != nullptr; }
+
+    int addVector(const std::string& module, const std::string& name, const VectorAttributes& attributes = {});
+    void append(int vector, int64_t eventNumber, int64_t rawTime, double value);
+    void flush();
+
+    uint64_t getSamplesWritten() const { return samplesWritten; }
+    uint64_t getBytesWritten() const { return offset; }
+
+private:
+    struct Column {
+        std::string module;
+        std::string name;
+        VectorAttributes attributes;
+        std::vector<int64_t> events;
+        std::vector<int64_t> times;
+        std::vector<double> values;
+        uint64_t count = 0;
+        std::vector<uint64_t> blockOffsets;
+    };
+
+    void writeBlock(int vector);
+    void write(const void* data, size_t size);
+
+    std::FILE* file = nullptr;
+    uint64_t offset = 0;
+    std::vector<Column> columns;
+    std::vector<uint8_t> scratch;
+    uint64_t samplesWritten = 0;
+};
+
+struct ColumnarVectorInfo {
+    std::string module;
+    std::string name;
+    VectorAttributes attributes;
+    uint64_t count = 0;
+    std::vector<uint64_t> blockOffsets;
+};
+
+struct ColumnarVectorData {
+    std::vector<int64_t> events;
+    std::vector<double> times;                     // Seconds
+    std::vector<double> values;
+};
+
+class ColumnarVectorReader {
+public:
+    // Reads the file and its directory, returns false (and fills error) on failure
+    bool open(const std::string& fileName, std::string& error);
+
+    const std::vector<ColumnarVectorInfo>& getVectors() const { return vectors; }
+    int find(const std::string& module, const std::string& name) const;
+    bool load(int vector, ColumnarVectorData& data, std::string& error) const;
+
+private:
+    std::vector<uint8_t> content;
+    std::vector<ColumnarVectorInfo> vectors;
+    double timeScale = 1;
+};
+
+} // namespace veins
+
+#endif // COLUMNARVECTORFILE_H
@@ -0,0 +1,158 @@
+#include "veins/modules/application/traci/DccController.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace veins;
+
+void DccController::configure(const DccParams& p, double interval, double power, double now) {
+    params = p;
+    defaultInterval = interval;
+    defaultTxPower = power;
+    size_t states = params.cbrThresholds.size() + 1;
+    if (params.mode == DccMode::Reactive &&
+        (params.beaconIntervals.size() != states || params.txPowers.size() != states)) {
+        throw std::invalid_argument("DCC needs one beacon interval and one tx power per state (thresholds + 1)");
+    }
+    if (!std::is_sorted(params.cbrThresholds.begin(), params.cbrThresholds.end())) {
+        throw std::invalid_argument("DCC CBR thresholds must be ascending");
+    }
+    if (params.relaxSamples < 1) {
+        params.relaxSamples = 1;
+    }
+    if (params.txPowerStep <= 0 || params.txPowerStep >= 1) {
+        throw std::invalid_argument("DCC tx power step must lie in (0, 1)");
+    }
+    if (params.mode == DccMode::Adaptive && params.frameAirtime <= 0) {
+        throw std::invalid_argument("DCC frame airtime must be positive");
+    }
+
+    // Never faster or louder than configured, in any state
+    for (double& stateInterval : params.beaconIntervals) {
+        stateInterval = std::max(stateInterval, defaultInterval);
+    }
+    for (double& statePower : params.txPowers) {
+        statePower = std::min(statePower, defaultTxPower);
+    }
+    params.minBeaconInterval = std::max(params.minBeaconInterval, defaultInterval);
+    params.maxBeaconInterval = std::max(params.maxBeaconInterval, params.minBeaconInterval);
+    params.minTxPower = std::min(params.minTxPower, defaultTxPower);
+    deltaMin = params.frameAirtime / params.maxBeaconInterval;
+    deltaMax = params.frameAirtime / params.minBeaconInterval;
+
+    state = 0;
+    samplesBelow = 0;
+    recentCbr.clear();
+    busyTime = 0;
+    busySince = -1;
+    periodStart = now;
+
+    beaconInterval = defaultInterval;
+    txPower = defaultTxPower;
+    if (params.mode == DccMode::Reactive) {
+        beaconInterval = params.beaconIntervals[0];
+        txPower = params.txPowers[0];
+    } else if (params.mode == DccMode::Adaptive) {
+        // Start from the duty cycle of the configured beacon interval
+        beaconInterval = std::max(params.minBeaconInterval, std::min(defaultInterval, params.maxBeaconInterval));
+        delta = std::max(deltaMin, std::min(params.frameAirtime / beaconInterval, deltaMax));
+    }
+}
+
+void DccController::channelBusy(bool busy, double now) {
+    if (busy && busySince < 0) {
+        busySince = now;
+    } else if (!busy && busySince >= 0) {
+        busyTime += now - busySince;
+        busySince = -1;
+    }
+}
+
+double DccController::measure(double now) {
+    // Account for a busy period that is still ongoing
+    if (busySince >= 0) {
+        busyTime += now - busySince;
+        busySince = now;
+    }
+
+    double period = now - periodStart;
+    double cbr = period > 0 ? std::min(1.0, busyTime / period) : 0.0;
+    periodStart = now;
+    busyTime = 0;
+
+    recentCbr.push_back(cbr);
+    while ((int)recentCbr.size() > params.relaxSamples) {
+        recentCbr.pop_front();
+    }
+
+    if (params.mode == DccMode::Reactive) {
+        updateReactive(cbr);
+    } else if (params.mode == DccMode::Adaptive) {
+        updateAdaptive(cbr);
+    }
+    return cbr;
+}
+
+double DccController::getSmoothedCbr() const {
+    if (recentCbr.empty()) {
+        return 0.0;
+    }
+    double sum = 0;
+    for (double cbr : recentCbr) {
+        sum += cbr;
+    }
+    return sum / recentCbr.size();
+}
+
+int DccController::stateFor(double cbr) const {
+    return std::upper_bound(params.cbrThresholds.begin(), params.cbrThresholds.end(), cbr) - params.cbrThresholds.begin();
+}
+
+void DccController::updateReactive(double cbr) {
+    // Tighten immediately on the latest two measurements...
+    double recentPeak = cbr;
+    if (recentCbr.size() >= 2) {
+        recentPeak = std::max(recentPeak, recentCbr[recentCbr.size() - 2]);
+    }
+    int target = stateFor(recentPeak);
+    if (target > state) {
+        state = target;
+        samplesBelow = 0;
+    }
+    // ... but relax one state at a time, after a full smoothing period below the threshold
+    else if (state > 0 && getSmoothedCbr() < params.cbrThresholds[state - 1]) {
+        if (++samplesBelow >= params.relaxSamples) {
+            state--;
+            samplesBelow = 0;
+        }
+    } else {
+        samplesBelow = 0;
+    }
+
+    beaconInterval = params.beaconIntervals[state];
+    txPower = params.txPowers[state];
+}
+
+void DccController::updateAdaptive(double cbr) {
+    // Smooth the CBR as the standard does (mean of the current and previous sample)
+    double cbrIts = cbr;
+    if (recentCbr.size() >= 2) {
+        cbrIts = 0.5 * (cbr + recentCbr[recentCbr.size() - 2]);
+    }
+
+    double offset = params.beta * (params.cbrTarget - cbrIts);
+    offset = offset > 0 ? std::min(offset, params.gainMaxPositive) : std::max(offset, -params.gainMaxNegative);
+    delta = (1 - params.alpha) * delta + offset;
+    delta = std::max(deltaMin, std::min(delta, deltaMax));
+
+    beaconInterval = std::max(params.minBeaconInterval, std::min(params.frameAirtime / delta, params.maxBeaconInterval));
+    state = stateFor(cbrIts);
+
+    // The rate alone cannot go lower: shed load with the tx power, and give
+    // the power back before the rate picks up again
+    bool rateAtFloor = delta <= deltaMin || beaconInterval >= params.maxBeaconInterval;
+    if (cbrIts > params.cbrTarget && rateAtFloor) {
+        txPower = std::max(params.minTxPower, txPower * params.txPowerStep);
+    } else if (cbrIts < params.cbrTarget && txPower < defaultTxPower) {
+        txPower = std::min(defaultTxPower, txPower / params.txPowerStep);
+    }
+}
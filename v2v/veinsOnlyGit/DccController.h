@@ -0,0 +1,94 @@
+#ifndef DCCCONTROLLER_H
+#define DCCCONTROLLER_H
+
+#include <deque>
+#include <vector>
+
+// Decentralized congestion control of the beacon rate, modelled after ETSI
+// TS 102 687. The channel busy ratio (CBR) is measured from the MAC's
+// busy/idle notifications; the reactive mode maps the CBR onto a table of
+// states (Relaxed, Active 1..n, Restrictive) each with its own beacon interval
+// and tx power, the adaptive mode runs the LIMERIC-style linear controller
+// that steers the own duty cycle towards a target CBR and, once the rate is at
+// its floor, steps the tx power down. DCC only ever sheds load: no state
+// beacons faster or louder than the configured beacon interval and tx power.
+// The adaptive duty cycle is bounded by the interval range rather than the
+// standard's fixed limits, so it spans every interval from the configured one
+// up to maxBeaconInterval.
+
+namespace veins {
+
+enum class DccMode {
+    Off,
+    Reactive,
+    Adaptive
+};
+
+struct DccParams {
+    DccMode mode = DccMode::Off;
+
+    // Reactive: thresholds.size() + 1 states, one interval/power per state
+    std::vector<double> cbrThresholds = {0.30, 0.40, 0.50, 0.60};
+    std::vector<double> beaconIntervals = {0.5, 0.6, 0.8, 1.0, 2.0};  // s, at least the configured interval
+    std::vector<double> txPowers = {20, 15, 10, 5, 1};               // mW, at most the configured power
+    int relaxSamples = 10;                         // Samples below threshold before relaxing
+
+    // Adaptive (ETSI TS 102 687 V1.2.1 defaults)
+    double cbrTarget = 0.68;
+    double alpha = 0.016;
+    double beta = 0.0012;
+    double gainMaxPositive = 0.0005;
+    double gainMaxNegative = 0.00025;
+    double frameAirtime = 0.0002;                  // s, on-air time of one beacon
+    double minBeaconInterval = 0.04;               // s
+    double maxBeaconInterval = 1.0;                // s
+    double minTxPower = 1.0;                       // mW
+    double txPowerStep = 0.8;                      // Power factor per measurement over target at the rate floor
+};
+
+class DccController {
+public:
+    // Starts measuring at now; throws std::invalid_argument on inconsistent tables
+    void configure(const DccParams& params, double interval, double power, double now);
+
+    // Channel state notification from the MAC
+    void channelBusy(bool busy, double now);
+
+    // Ends a measurement period, returns its CBR and updates the state
+    double measure(double now);
+
+    bool isEnabled() const { return params.mode != DccMode::Off; }
+    int getState() const { return state; }
+    int getStateCount() const { return (int)params.cbrThresholds.size() + 1; }
+    double getBeaconInterval() const { return beaconInterval; }
+    double getTxPower() const { return txPower; }
+    double getSmoothedCbr() const;
+
+private:
+    void updateReactive(double cbr);
+    void updateAdaptive(double cbr);
+    int stateFor(double cbr) const;
+
+    DccParams params;
+
+    // CBR measurement
+    double periodStart = 0;
+    double busySince = -1;
+    double busyTime = 0;
+    std::deque<double> recentCbr;                  // Last relaxSamples measurements
+
+    // Output
+    int state = 0;
+    int samplesBelow = 0;
+    double delta = 0;                              // Adaptive: allowed duty cycle
+    double deltaMin = 0;                           // Adaptive: duty cycle at maxBeaconInterval
+    double deltaMax = 0;                           // Adaptive: duty cycle at minBeaconInterval
+    double beaconInterval = 1.0;
+    double txPower = 20;
+    double defaultInterval = 1.0;                  // Configured beacon interval and power, the upper limits
+    double defaultTxPower = 20;
+};
+
+} // namespace veins
+
+#endif // DCCCONTROLLER_H
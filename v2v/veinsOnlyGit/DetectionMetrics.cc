@@ -0,0 +1,84 @@
+#include "veins/modules/application/traci/DetectionMetrics.h"
+
+using namespace veins;
+
+void DetectionCounts::add(const DetectionCounts& other) {
+    truePositives += other.truePositives;
+    falsePositives += other.falsePositives;
+    attackerPairs += other.attackerPairs;
+    attackerPairsDetected += other.attackerPairsDetected;
+    benignPairs += other.benignPairs;
+    benignPairsFlagged += other.benignPairsFlagged;
+    totalTimeToDetect += other.totalTimeToDetect;
+}
+
+double DetectionCounts::precision() const {
+    long flagged = attackerPairsDetected + benignPairsFlagged;
+    return flagged > 0 ? (double)attackerPairsDetected / flagged : 0.0;
+}
+
+double DetectionCounts::recall() const {
+    return attackerPairs > 0 ? (double)attackerPairsDetected / attackerPairs : 0.0;
+}
+
+double DetectionCounts::falsePositiveRate() const {
+    return benignPairs > 0 ? (double)benignPairsFlagged / benignPairs : 0.0;
+}
+
+double DetectionCounts::meanTimeToDetect() const {
+    return attackerPairsDetected > 0 ? totalTimeToDetect / attackerPairsDetected : 0.0;
+}
+
+MetricsUpdate DetectionMetrics::observe(int senderId, bool senderMalicious, const DetectionResult& result, bool blacklisted, double now) {
+    MetricsUpdate update;
+
+    SenderState& state = senders[senderId];
+    if (state.firstSeen < 0) {
+        state.firstSeen = now;
+        state.malicious = senderMalicious;
+        update.newPair = true;
+        if (senderMalicious) {
+            counts.attackerPairs++;
+        } else {
+            counts.benignPairs++;
+        }
+    }
+
+    // Blocked receptions are detections too, the ones after the first
+    if (result.verdict != DetectionVerdict::Accepted) {
+        if (senderMalicious) {
+            counts.truePositives++;
+            update.truePositive = true;
+        } else {
+            counts.falsePositives++;
+            update.falsePositive = true;
+        }
+    }
+
+    if (result.verdict != DetectionVerdict::Accepted && state.firstFlagged < 0) {
+        state.firstFlagged = now;
+        if (senderMalicious) {
+            counts.attackerPairsDetected++;
+            update.timeToDetect = now - state.firstSeen;
+            counts.totalTimeToDetect += update.timeToDetect;
+        } else {
+            counts.benignPairsFlagged++;
+        }
+    }
+
+    // Blacklist dwell time: from the decision to blacklist until release
+    if (blacklisted && state.blacklistStart < 0) {
+        state.blacklistStart = now;
+    } else if (!blacklisted && state.blacklistStart >= 0) {
+        update.blacklistDwell = now - state.blacklistStart;
+        update.dwellMalicious = state.malicious;
+        state.blacklistStart = -1;
+    }
+
+    return update;
+}
+
+void DetectionMetrics::clear() {
+    senders.clear();
+    counts = DetectionCounts();
+}
@@ -0,0 +1,75 @@
+#ifndef DETECTIONMETRICS_H
+#define DETECTIONMETRICS_H
+
+#include <unordered_map>
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+// Ground-truth-aware detection accuracy, updated incrementally per reception.
+// "Pairs" are (receiver, sender) combinations: a receiver that hears an
+// attacker and flags it at least once counts as one detected attacker pair.
+
+namespace veins {
+
+struct DetectionCounts {
+    long truePositives = 0;                        // Detected or blocked receptions from malicious senders
+    long falsePositives = 0;                       // Detected or blocked receptions from benign senders
+    long attackerPairs = 0;                        // Malicious senders heard
+    long attackerPairsDetected = 0;                // ... flagged at least once
+    long benignPairs = 0;                          // Benign senders heard
+    long benignPairsFlagged = 0;                   // ... flagged at least once
+    double totalTimeToDetect = 0.0;                // Sum over detected attacker pairs
+
+    void add(const DetectionCounts& other);
+
+    double precision() const;
+    double recall() const;
+    double falsePositiveRate() const;
+    double meanTimeToDetect() const;
+};
+
+// What a single observation changed, for recording into histograms/vectors
+struct MetricsUpdate {
+    bool newPair = false;                          // First reception from this sender
+    bool truePositive = false;                     // Detection against a malicious sender
+    bool falsePositive = false;                    // Detection against a benign sender
+    double timeToDetect = -1;                      // >= 0 on the first flag of an attacker
+    double blacklistDwell = -1;                    // >= 0 when a blacklist period ended
+    bool dwellMalicious = false;                   // Ground truth of the released sender
+};
+
+class DetectionMetrics {
+public:
+    // Feed one detector decision; blacklisted is the sender's state afterwards
+    MetricsUpdate observe(int senderId, bool senderMalicious, const DetectionResult& result, bool blacklisted, double now);
+
+    // Ends all open blacklist periods at the end of the run
+    template <typename Callback>
+    void closeBlacklistPeriods(double now, Callback onDwell)
+    {
+        for (auto& entry : senders) {
+            SenderState& state = entry.second;
+            if (state.blacklistStart >= 0) {
+                onDwell(now - state.blacklistStart, state.malicious);
+                state.blacklistStart = -1;
+            }
+        }
+    }
+
+    const DetectionCounts& getCounts() const { return counts; }
+    void clear();
+
+private:
+    struct SenderState {
+        double firstSeen = -1;                     // First reception
+        double firstFlagged = -1;                  // First non-accepted verdict
+        double blacklistStart = -1;                // Start of current blacklist period
+        bool malicious = false;                    // Ground truth
+    };
+
+    std::unordered_map<int, SenderState> senders;
+    DetectionCounts counts;
+};
+
+} // namespace veins
+
+#endif // DETECTIONMETRICS_H
@@ -0,0 +1,146 @@
+#include "veins/modules/application/traci/DetectionTrace.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace veins;
+
+namespace {
+
+const char traceMagic[8] = {'V', '2', 'V', 'T', 'R', 'A', 'C', 'E'};
+const size_t bufferedRecords = 4096;
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+} // namespace
+
+DetectionTraceWriter::~DetectionTraceWriter() {
+    close();
+}
+
+bool DetectionTraceWriter::open(const std::string& fileName) {
+    close();
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    TraceHeader header;
+    std::memcpy(header.magic, traceMagic, sizeof(header.magic));
+    header.version = version;
+    header.recordSize = sizeof(TraceRecord);
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    buffer.reserve(bufferedRecords);
+    recordsWritten = 0;
+    return true;
+}
+
+void DetectionTraceWriter::close() {
+    if (!file) {
+        return;
+    }
+    flush();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void DetectionTraceWriter::writeNode(int nodeId, bool malicious) {
+    TraceRecord record;
+    record.type = (uint8_t)TraceRecordType::Node;
+    record.flags = malicious ? 1 : 0;
+    record.receiverId = nodeId;
+    append(record);
+}
+
+void DetectionTraceWriter::writeReception(const ReceptionEvent& ev) {
+    TraceRecord record;
+    record.type = (uint8_t)TraceRecordType::Reception;
+    record.receiverId = ev.receiverId;
+    record.senderId = ev.senderId;
+    record.posX = (float)ev.posX;
+    record.posY = (float)ev.posY;
+    record.speedX = (float)ev.speedX;
+    record.speedY = (float)ev.speedY;
+    record.time = ev.time;
+    record.timestamp = ev.timestamp;
+    append(record);
+}
+
+void DetectionTraceWriter::append(const TraceRecord& record) {
+    if (!file) {
+        return;
+    }
+    buffer.push_back(record);
+    if (buffer.size() >= bufferedRecords) {
+        flush();
+    }
+}
+
+void DetectionTraceWriter::flush() {
+    if (!buffer.empty()) {
+        std::fwrite(buffer.data(), sizeof(TraceRecord), buffer.size(), file);
+        recordsWritten += buffer.size();
+        buffer.clear();
+    }
+}
+
+bool DetectionTrace::isMalicious(int nodeId) const {
+    return std::binary_search(maliciousNodes.begin(), maliciousNodes.end(), nodeId);
+}
+
+bool veins::readDetectionTrace(const std::string& fileName, DetectionTrace& trace, std::string& error) {
+    std::FILE* file = std::fopen(fileName.c_str(), "rb");
+    if (!file) {
+        error = "cannot open " + fileName;
+        return false;
+    }
+
+    TraceHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, traceMagic, sizeof(traceMagic)) != 0) {
+        error = fileName + " is not a detection trace";
+        std::fclose(file);
+        return false;
+    }
+    if (header.version != DetectionTraceWriter::version || header.recordSize != sizeof(TraceRecord)) {
+        error = fileName + ": unsupported trace version " + std::to_string(header.version);
+        std::fclose(file);
+        return false;
+    }
+
+    trace = DetectionTrace();
+    std::vector<TraceRecord> chunk(bufferedRecords);
+    size_t n;
+    while ((n = std::fread(chunk.data(), sizeof(TraceRecord), chunk.size(), file)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            const TraceRecord& record = chunk[i];
+            if (record.type == (uint8_t)TraceRecordType::Node) {
+                if (record.flags & 1) {
+                    trace.maliciousNodes.push_back(record.receiverId);
+                } else {
+                    trace.benignNodes.push_back(record.receiverId);
+                }
+            } else if (record.type == (uint8_t)TraceRecordType::Reception) {
+                ReceptionEvent ev;
+                ev.receiverId = record.receiverId;
+                ev.senderId = record.senderId;
+                ev.time = record.time;
+                ev.posX = record.posX;
+                ev.posY = record.posY;
+                ev.speedX = record.speedX;
+                ev.speedY = record.speedY;
+                ev.timestamp = record.timestamp;
+                trace.events.push_back(ev);
+            }
+        }
+    }
+    std::fclose(file);
+
+    std::sort(trace.maliciousNodes.begin(), trace.maliciousNodes.end());
+    std::sort(trace.benignNodes.begin(), trace.benignNodes.end());
+    return true;
+}
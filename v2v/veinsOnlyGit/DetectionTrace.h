@@ -0,0 +1,76 @@
+#ifndef DETECTIONTRACE_H
+#define DETECTIONTRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+// Compact binary trace of detector input, written by MyVeinsApp and read back
+// by the offline replay tool. Layout: a 16 byte header ("V2VTRACE", version,
+// record size) followed by fixed-size little-endian records. Node records carry
+// the ground truth (malicious flag) for every node id, reception records carry
+// one ReceptionEvent.
+
+namespace veins {
+
+enum class TraceRecordType : uint8_t {
+    Node = 1,
+    Reception = 2
+};
+
+struct TraceRecord {
+    uint8_t type = 0;                              // TraceRecordType
+    uint8_t flags = 0;                             // Node: bit 0 = malicious
+    uint16_t reserved = 0;
+    int32_t receiverId = -1;                       // Node: node id
+    int32_t senderId = -1;
+    float posX = 0;
+    float posY = 0;
+    float speedX = 0;
+    float speedY = 0;
+    uint32_t padding = 0;
+    double time = 0;
+    double timestamp = 0;
+};
+
+static_assert(sizeof(TraceRecord) == 48, "TraceRecord layout must stay fixed");
+
+class DetectionTraceWriter {
+public:
+    static const uint32_t version = 1;
+
+    ~DetectionTraceWriter();
+
+    bool open(const std::string& fileName);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void writeNode(int nodeId, bool malicious);
+    void writeReception(const ReceptionEvent& ev);
+    uint64_t getRecordsWritten() const { return recordsWritten; }
+
+private:
+    void append(const TraceRecord& record);
+    void flush();
+
+    std::FILE* file = nullptr;
+    std::vector<TraceRecord> buffer;
+    uint64_t recordsWritten = 0;
+};
+
+struct DetectionTrace {
+    std::vector<ReceptionEvent> events;            // In recording order
+    std::vector<int> maliciousNodes;               // Sorted node ids
+    std::vector<int> benignNodes;                  // Sorted node ids
+
+    bool isMalicious(int nodeId) const;
+};
+
+// Reads a whole trace into memory, returns false (and fills error) on failure
+bool readDetectionTrace(const std::string& fileName, DetectionTrace& trace, std::string& error);
+
+} // namespace veins
+
+#endif // DETECTIONTRACE_H
@@ -0,0 +1,56 @@
+#include "veins/modules/application/traci/DownsampledOutVector.h"
+#include <algorithm>
+
+using namespace veins;
+
+void DownsampledOutVector::setName(const char* name) {
+    this->name = name;
+    rawVector.setName(name);
+    countVector.setName((this->name + ":count").c_str());
+    minVector.setName((this->name + ":min").c_str());
+    maxVector.setName((this->name + ":max").c_str());
+    meanVector.setName((this->name + ":mean").c_str());
+    p95Vector.setName((this->name + ":p95").c_str());
+}
+
+void DownsampledOutVector::setInterval(simtime_t interval) {
+    this->interval = interval;
+    if (interval > 0) {
+        aggregator.configure(interval.dbl());
+    }
+}
+
+void DownsampledOutVector::record(double value) {
+    samples++;
+    if (interval <= 0) {
+        rawVector.record(value);
+        rowsWritten++;
+        return;
+    }
+    aggregator.add(simTime().dbl(), value);
+    if (aggregator.full()) {
+        writeIntervals();
+    }
+}
+
+void DownsampledOutVector::flush() {
+    if (interval <= 0) {
+        return;
+    }
+    aggregator.close(simTime().dbl());
+    writeIntervals();
+}
+
+void DownsampledOutVector::writeIntervals() {
+    simtime_t now = simTime();
+    aggregator.drain([&](const IntervalSummary& summary) {
+        // Stamped with the interval end, which never lies in the future
+        simtime_t t = std::min(simtime_t(summary.end), now);
+        countVector.recordWithTimestamp(t, summary.count);
+        minVector.recordWithTimestamp(t, summary.min);
+        maxVector.recordWithTimestamp(t, summary.max);
+        meanVector.recordWithTimestamp(t, summary.mean);
+        p95Vector.recordWithTimestamp(t, summary.p95);
+        rowsWritten++;
+    });
+}
@@ -0,0 +1,49 @@
+#ifndef DOWNSAMPLEDOUTVECTOR_H
+#define DOWNSAMPLEDOUTVECTOR_H
+
+#include <string>
+#include <omnetpp.h>
+#include "veins/modules/application/traci/IntervalAggregator.h"
+
+using namespace omnetpp;
+
+namespace veins {
+
+// Drop-in for a cOutVector fed on every packet. With an interval set, samples
+// are aggregated in memory and one row per interval goes to the vectors
+// "<name>:count", ":min", ":max", ":mean" and ":p95", written in batches as
+// the ring of closed intervals fills and at flush(). Without an interval every
+// sample is recorded to "<name>" as before.
+class DownsampledOutVector {
+public:
+    void setName(const char* name);
+    void setInterval(simtime_t interval);
+
+    void record(double value);
+    void record(simtime_t value) { record(value.dbl()); }
+
+    // Writes the pending intervals, call from finish()
+    void flush();
+
+    uint64_t getSamples() const { return samples; }
+    uint64_t getRowsWritten() const { return rowsWritten; }
+
+private:
+    void writeIntervals();
+
+    std::string name;
+    simtime_t interval;
+    IntervalAggregator aggregator;
+    cOutVector rawVector;
+    cOutVector countVector;
+    cOutVector minVector;
+    cOutVector maxVector;
+    cOutVector meanVector;
+    cOutVector p95Vector;
+    uint64_t samples = 0;
+    uint64_t rowsWritten = 0;
+};
+
+} // namespace veins
+
+#endif // DOWNSAMPLEDOUTVECTOR_H
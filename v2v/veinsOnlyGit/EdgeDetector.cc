@@ -0,0 +1,254 @@
+#include "veins/modules/application/traci/EdgeDetector.h"
+#include "veins/modules/application/traci/Varint.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace veins;
+
+const char* veins::edgeReasonName(EdgeReason reason) {
+    switch (reason) {
+        case EdgeReason::None: return "none";
+        case EdgeReason::Flood: return "flood";
+        case EdgeReason::Spoof: return "spoof";
+        case EdgeReason::Replay: return "replay";
+    }
+    return "unknown";
+}
+
+EdgeDetector::EdgeDetector(const EdgeParams& params)
+    : params(params) {
+}
+
+EdgeDetector::SenderState& EdgeDetector::slotFor(int senderId) {
+    auto it = slotOf.find(senderId);
+    if (it != slotOf.end()) {
+        return table[it->second];
+    }
+    slotOf.emplace(senderId, table.size());
+    table.emplace_back();
+    table.back().senderId = senderId;
+    return table.back();
+}
+
+EdgeReason EdgeDetector::observe(const ReceptionEvent& ev) {
+    SenderState& state = slotFor(ev.senderId);
+    double now = ev.time;
+
+    EdgeReason reason = EdgeReason::None;
+    if (rateOf(state, now) > params.floodRate) {
+        reason = EdgeReason::Flood;
+    } else {
+        reason = checkKinematics(state, ev);
+    }
+
+    if (reason == EdgeReason::None) {
+        // Only plausible beacons move the reference point
+        state.lastTimestamp = ev.timestamp;
+        state.lastPosX = ev.posX;
+        state.lastPosY = ev.posY;
+        state.lastSpeedX = ev.speedX;
+        state.lastSpeedY = ev.speedY;
+    } else {
+        state.reason = reason;
+        state.flaggedUntil = now + params.verdictDuration;
+        state.detections++;
+    }
+    state.lastSeen = now;
+
+    return state.flaggedUntil > now ? state.reason : EdgeReason::None;
+}
+
+double EdgeDetector::rateOf(SenderState& state, double now) {
+    double sliceLength = params.window / rateBuckets;
+    int64_t bucket = (int64_t)std::floor(now / sliceLength);
+
+    // Clear the slices that passed since the last message
+    int64_t stale = std::min<int64_t>(bucket - state.newestBucket, rateBuckets);
+    if (state.lastSeen < 0) {
+        stale = rateBuckets;
+    }
+    for (int64_t i = 1; i <= stale; i++) {
+        state.bucketCounts[(state.newestBucket + i) % rateBuckets] = 0;
+    }
+    state.newestBucket = std::max(state.newestBucket, bucket);
+
+    uint16_t& current = state.bucketCounts[bucket % rateBuckets];
+    if (current < UINT16_MAX) {
+        current++;
+    }
+
+    int count = 0;
+    for (uint16_t slice : state.bucketCounts) {
+        count += slice;
+    }
+    return count / params.window;
+}
+
+double EdgeDetector::currentRate(const SenderState& state, double now) const {
+    double sliceLength = params.window / rateBuckets;
+    int64_t bucket = (int64_t)std::floor(now / sliceLength);
+    int count = 0;
+    for (int k = 0; k < rateBuckets; k++) {
+        int64_t slice = state.newestBucket - k;
+        if (slice > bucket - rateBuckets && slice <= bucket) {
+            count += state.bucketCounts[slice % rateBuckets];
+        }
+    }
+    return count / params.window;
+}
+
+EdgeReason EdgeDetector::checkKinematics(const SenderState& state, const ReceptionEvent& ev) const {
+    if (!std::isfinite(ev.posX) || !std::isfinite(ev.posY)) {
+        return EdgeReason::Spoof;
+    }
+
+    // Claimed position must be within radio range of this RSU
+    double dx = ev.posX - anchorX;
+    double dy = ev.posY - anchorY;
+    if (dx * dx + dy * dy > params.maxRange * params.maxRange) {
+        return EdgeReason::Spoof;
+    }
+
+    if (ev.speedX * ev.speedX + ev.speedY * ev.speedY > params.maxSpeed * params.maxSpeed) {
+        return EdgeReason::Spoof;
+    }
+
+    if (ev.timestamp > ev.time || ev.time - ev.timestamp > params.maxMessageAge) {
+        return EdgeReason::Replay;
+    }
+
+    if (state.lastTimestamp >= 0) {
+        if (ev.timestamp <= state.lastTimestamp) {
+            return EdgeReason::Replay;
+        }
+
+        // Movement since the last beacon must fit the speed limit
+        double dt = ev.timestamp - state.lastTimestamp;
+        double mx = ev.posX - state.lastPosX;
+        double my = ev.posY - state.lastPosY;
+        double reach = params.maxSpeed * dt + params.positionTolerance;
+        if (mx * mx + my * my > reach * reach) {
+            return EdgeReason::Spoof;
+        }
+    }
+
+    return EdgeReason::None;
+}
+
+bool EdgeDetector::isFlagged(int senderId, double now) const {
+    auto it = slotOf.find(senderId);
+    return it != slotOf.end() && table[it->second].flaggedUntil > now;
+}
+
+ReputationSnapshot EdgeDetector::snapshot(const SenderState& state, double now) const {
+    ReputationSnapshot snapshot;
+    snapshot.senderId = state.senderId;
+    snapshot.rate = state.lastSeen < 0 ? 0 : currentRate(state, now);
+    snapshot.detections = state.detections;
+    snapshot.reason = state.reason;
+    snapshot.flaggedUntil = state.flaggedUntil;
+    snapshot.lastTimestamp = state.lastTimestamp;
+    snapshot.posX = state.lastPosX;
+    snapshot.posY = state.lastPosY;
+    snapshot.speedX = state.lastSpeedX;
+    snapshot.speedY = state.lastSpeedY;
+    return snapshot;
+}
+
+void EdgeDetector::import(const ReputationSnapshot& snapshot, double now) {
+    bool known = slotOf.count(snapshot.senderId) > 0;
+    SenderState& state = slotFor(snapshot.senderId);
+
+    if (!known) {
+        // Seed the rate window with the neighbour's estimate
+        double sliceLength = params.window / rateBuckets;
+        state.newestBucket = (int64_t)std::floor(now / sliceLength);
+        double seeded = std::min(snapshot.rate * params.window, (double)UINT16_MAX);
+        state.bucketCounts[state.newestBucket % rateBuckets] = (uint16_t)seeded;
+        state.lastSeen = now;
+        state.lastTimestamp = snapshot.lastTimestamp;
+        state.lastPosX = snapshot.posX;
+        state.lastPosY = snapshot.posY;
+        state.lastSpeedX = snapshot.speedX;
+        state.lastSpeedY = snapshot.speedY;
+    }
+
+    state.detections = std::max(state.detections, snapshot.detections);
+    if (snapshot.flaggedUntil > state.flaggedUntil) {
+        state.flaggedUntil = snapshot.flaggedUntil;
+        state.reason = snapshot.reason;
+    }
+}
+
+size_t EdgeDetector::evictIdle(double now) {
+    size_t evicted = 0;
+    for (size_t i = 0; i < table.size();) {
+        const SenderState& state = table[i];
+        if (now - state.lastSeen > params.idleTimeout && state.flaggedUntil <= now) {
+            slotOf.erase(state.senderId);
+            if (i + 1 != table.size()) {
+                table[i] = table.back();
+                slotOf[table[i].senderId] = i;
+            }
+            table.pop_back();
+            evicted++;
+        } else {
+            i++;
+        }
+    }
+    return evicted;
+}
+
+void EdgeDetector::clear() {
+    table.clear();
+    slotOf.clear();
+}
+
+// ==================== MIGRATION ENCODING ====================
+
+void veins::appendReputation(std::vector<uint8_t>& out, const ReputationSnapshot& snapshot, double now) {
+    putVarint(out, zigzag(snapshot.senderId));
+    putVarint(out, std::llround(std::max(0.0, snapshot.rate) * 10));
+    putVarint(out, snapshot.detections);
+    out.push_back((uint8_t)snapshot.reason);
+    putVarint(out, std::llround(std::max(0.0, snapshot.flaggedUntil - now) * 1e3));
+    // Age of the last timestamp + 1 so that 0 means "none"
+    putVarint(out, snapshot.lastTimestamp < 0 ? 0 : std::llround(std::max(0.0, now - snapshot.lastTimestamp) * 1e6) + 1);
+    putVarint(out, zigzag(std::llround(snapshot.posX * 100)));
+    putVarint(out, zigzag(std::llround(snapshot.posY * 100)));
+    putVarint(out, zigzag(std::llround(snapshot.speedX * 100)));
+    putVarint(out, zigzag(std::llround(snapshot.speedY * 100)));
+}
+
+bool veins::decodeReputation(const std::vector<uint8_t>& payload, double now, std::vector<ReputationSnapshot>& snapshots) {
+    snapshots.clear();
+    size_t pos = 0;
+    while (pos < payload.size()) {
+        uint64_t senderId, rate, detections, remaining, age, posX, posY, speedX, speedY;
+        if (!getVarint(payload, pos, senderId) || !getVarint(payload, pos, rate) ||
+            !getVarint(payload, pos, detections) || pos >= payload.size()) {
+            return false;
+        }
+        uint8_t reason = payload[pos++];
+        if (reason > (uint8_t)EdgeReason::Replay ||
+            !getVarint(payload, pos, remaining) || !getVarint(payload, pos, age) ||
+            !getVarint(payload, pos, posX) || !getVarint(payload, pos, posY) ||
+            !getVarint(payload, pos, speedX) || !getVarint(payload, pos, speedY)) {
+            return false;
+        }
+
+        ReputationSnapshot snapshot;
+        snapshot.senderId = (int32_t)unzigzag(senderId);
+        snapshot.rate = rate / 10.0;
+        snapshot.detections = (uint32_t)detections;
+        snapshot.reason = (EdgeReason)reason;
+        snapshot.flaggedUntil = remaining > 0 ? now + remaining / 1e3 : -1;
+        snapshot.lastTimestamp = age > 0 ? now - (age - 1) / 1e6 : -1;
+        snapshot.posX = unzigzag(posX) / 100.0;
+        snapshot.posY = unzigzag(posY) / 100.0;
+        snapshot.speedX = unzigzag(speedX) / 100.0;
+        snapshot.speedY = unzigzag(speedY) / 100.0;
+        snapshots.push_back(snapshot);
+    }
+    return true;
+}
@@ -0,0 +1,128 @@
+#ifndef EDGEDETECTOR_H
+#define EDGEDETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+// Cell-wide detector run by an RSU for every sender it hears. All per-sender
+// state lives in one contiguous table (rate buckets, last kinematics, verdict)
+// reached through an ID -> slot index, so thousands of senders cost a few
+// cache lines each and idle senders are removed by swapping with the last slot.
+//
+// Checks, per reception:
+//  Flood   - messages in the sliding window above floodRate
+//  Spoof   - claimed position out of radio range of the RSU, not finite, or a
+//            jump since the last beacon that the claimed speed cannot explain
+//  Replay  - stale timestamp, or a timestamp not newer than the last one seen
+
+namespace veins {
+
+struct EdgeParams {
+    double floodRate = 20.0;                       // Messages/s per sender
+    double window = 1.0;                           // Rate window (s)
+    double maxSpeed = 50.0;                        // m/s
+    double positionTolerance = 30.0;               // Slack on position jumps (m)
+    double maxRange = 1000.0;                      // Beyond this from the RSU a claim is implausible (m)
+    double maxMessageAge = 5.0;                    // s
+    double verdictDuration = 10.0;                 // How long a flagged sender stays flagged (s)
+    double idleTimeout = 30.0;                     // Forget senders not heard for this long (s)
+};
+
+enum class EdgeReason : uint8_t {
+    None,
+    Flood,
+    Spoof,
+    Replay
+};
+
+const char* edgeReasonName(EdgeReason reason);
+
+// What an RSU hands over to a neighbouring RSU about one sender
+struct ReputationSnapshot {
+    int32_t senderId = -1;
+    double rate = 0;                               // Messages/s over the rate window
+    uint32_t detections = 0;                       // Suspicion level
+    EdgeReason reason = EdgeReason::None;
+    double flaggedUntil = -1;                      // Verdict expiry, absolute
+    double lastTimestamp = -1;                     // Last plausible beacon
+    double posX = 0;
+    double posY = 0;
+    double speedX = 0;
+    double speedY = 0;
+};
+
+// Compact migration encoding: varints, times relative to now (ms/us),
+// kinematics in cm. Roughly 15-25 bytes per sender.
+void appendReputation(std::vector<uint8_t>& out, const ReputationSnapshot& snapshot, double now);
+bool decodeReputation(const std::vector<uint8_t>& payload, double now, std::vector<ReputationSnapshot>& snapshots);
+
+class EdgeDetector {
+public:
+    static const int rateBuckets = 8;
+
+    struct SenderState {
+        int32_t senderId = -1;
+        EdgeReason reason = EdgeReason::None;      // Reason of the current verdict
+        uint16_t bucketCounts[rateBuckets] = {};   // Messages per window/rateBuckets slice
+        int64_t newestBucket = 0;                  // Absolute index of the newest slice
+        double lastSeen = -1;
+        double lastTimestamp = -1;
+        double lastPosX = 0;
+        double lastPosY = 0;
+        double lastSpeedX = 0;
+        double lastSpeedY = 0;
+        double flaggedUntil = -1;
+        uint32_t detections = 0;
+    };
+
+    explicit EdgeDetector(const EdgeParams& params = EdgeParams());
+
+    void setParams(const EdgeParams& p) { params = p; }
+    const EdgeParams& getParams() const { return params; }
+    void setAnchor(double x, double y) { anchorX = x; anchorY = y; }
+
+    // Returns the reason if the sender is flagged after this reception
+    EdgeReason observe(const ReceptionEvent& ev);
+
+    bool isFlagged(int senderId, double now) const;
+
+    template <typename F>
+    void forEachFlagged(double now, F callback) const {
+        for (const SenderState& state : table) {
+            if (state.flaggedUntil > now) {
+                callback(state);
+            }
+        }
+    }
+
+    // Handover support: export a sender's state, or fold in one received from
+    // a neighbouring RSU (keeping the stricter of both verdicts)
+    ReputationSnapshot snapshot(const SenderState& state, double now) const;
+    void import(const ReputationSnapshot& snapshot, double now);
+
+    // Drop senders not heard for idleTimeout, returns how many
+    size_t evictIdle(double now);
+
+    size_t size() const { return table.size(); }
+    const std::vector<SenderState>& getTable() const { return table; }
+    void clear();
+
+private:
+    SenderState& slotFor(int senderId);
+    double rateOf(SenderState& state, double now);
+    double currentRate(const SenderState& state, double now) const;
+    EdgeReason checkKinematics(const SenderState& state, const ReceptionEvent& ev) const;
+
+    EdgeParams params;
+    double anchorX = 0;
+    double anchorY = 0;
+    std::vector<SenderState> table;
+    std::unordered_map<int, uint32_t> slotOf;      // Sender ID -> index into table
+};
+
+} // namespace veins
+
+#endif // EDGEDETECTOR_H
@@ -0,0 +1,87 @@
+#include "veins/modules/application/traci/IntervalAggregator.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace veins;
+
+void IntervalAggregator::configure(double interval, size_t ringSize, size_t reservoirSize) {
+    this->interval = interval;
+    this->reservoirSize = std::max<size_t>(1, reservoirSize);
+    ring.assign(std::max<size_t>(1, ringSize), IntervalSummary());
+    reservoir.clear();
+    reservoir.reserve(this->reservoirSize);
+    currentStart = 0;
+    count = 0;
+    head = completed = 0;
+    samples = intervals = 0;
+}
+
+void IntervalAggregator::add(double time, double value) {
+    if (time >= currentStart + interval) {
+        closeCurrent(currentStart + interval);
+        currentStart = std::floor(time / interval) * interval;
+    }
+
+    if (count == 0) {
+        min = max = value;
+        sum = 0;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    sum += value;
+    count++;
+    samples++;
+
+    // Reservoir sampling (algorithm R)
+    if (reservoir.size() < reservoirSize) {
+        reservoir.push_back(value);
+    } else {
+        uint64_t slot = nextRandom() % uint64_t(count);
+        if (slot < reservoirSize) {
+            reservoir[slot] = value;
+        }
+    }
+}
+
+void IntervalAggregator::close(double time) {
+    closeCurrent(std::min(time, currentStart + interval));
+}
+
+void IntervalAggregator::closeCurrent(double end) {
+    if (count == 0) {
+        return;
+    }
+    if (full()) {
+        // Owner did not drain, overwrite the oldest interval
+        head = (head + 1) % ring.size();
+        completed--;
+    }
+
+    IntervalSummary& summary = ring[(head + completed) % ring.size()];
+    summary.start = currentStart;
+    summary.end = end;
+    summary.count = count;
+    summary.min = min;
+    summary.max = max;
+    summary.mean = sum / count;
+
+    // Nearest rank on the reservoir
+    size_t rank = size_t(std::ceil(0.95 * reservoir.size()));
+    rank = rank > 0 ? rank - 1 : 0;
+    std::nth_element(reservoir.begin(), reservoir.begin() + rank, reservoir.end());
+    summary.p95 = reservoir[rank];
+
+    completed++;
+    intervals++;
+    count = 0;
+    reservoir.clear();
+}
+
+uint64_t IntervalAggregator::nextRandom() {
+    // xorshift64*
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return rngState * 2685821657736338717ULL;
+}
@@ -0,0 +1,80 @@
+#ifndef INTERVALAGGREGATOR_H
+#define INTERVALAGGREGATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Downsamples a high-rate time series into fixed-length intervals. Each
+// interval keeps its count, min, max and sum, and a fixed-size reservoir
+// sample for the 95th percentile (exact while an interval has no more samples
+// than the reservoir holds). Closed intervals go into a ring of fixed capacity
+// that the owner drains in batches.
+
+namespace veins {
+
+struct IntervalSummary {
+    double start = 0;                              // Interval [start, end)
+    double end = 0;
+    long count = 0;
+    double min = 0;
+    double max = 0;
+    double mean = 0;
+    double p95 = 0;
+};
+
+class IntervalAggregator {
+public:
+    static const size_t defaultRingSize = 64;
+    static const size_t defaultReservoirSize = 128;
+
+    // interval > 0; starts the first interval at 0
+    void configure(double interval, size_t ringSize = defaultRingSize, size_t reservoirSize = defaultReservoirSize);
+
+    // Closes the current interval first if time lies beyond it
+    void add(double time, double value);
+
+    // Closes the current interval (if it has samples) early, ending it at time
+    void close(double time);
+
+    bool full() const { return completed == ring.size(); }
+    size_t size() const { return completed; }
+
+    // Oldest first; summaries stay valid until the next add() or close()
+    template <typename F>
+    void drain(F&& f) {
+        for (size_t i = 0; i < completed; i++) {
+            f(ring[(head + i) % ring.size()]);
+        }
+        head = (head + completed) % ring.size();
+        completed = 0;
+    }
+
+    uint64_t getSamples() const { return samples; }
+    uint64_t getIntervals() const { return intervals; }
+
+private:
+    void closeCurrent(double end);
+    uint64_t nextRandom();
+
+    double interval = 1;
+    double currentStart = 0;
+    long count = 0;
+    double min = 0;
+    double max = 0;
+    double sum = 0;
+    std::vector<double> reservoir;
+    size_t reservoirSize = defaultReservoirSize;
+    uint64_t rngState = 0x9e3779b97f4a7c15ULL;     // Own stream, leaves the simulation RNGs alone
+
+    std::vector<IntervalSummary> ring;
+    size_t head = 0;
+    size_t completed = 0;
+
+    uint64_t samples = 0;
+    uint64_t intervals = 0;
+};
+
+} // namespace veins
+
+#endif // INTERVALAGGREGATOR_H
@@ -1,5 +1,14 @@
 #include "veins/modules/application/traci/MyVeinsApp.h"
+#include "veins/modules/application/traci/AdmissionFilter.h"
 #include "veins/modules/messages/MyMsg_m.h"
+#include "veins/modules/messages/MisbehaviorReport_m.h"
+#include "veins/modules/messages/RevocationUpdate_m.h"
+#include "veins/modules/messages/EdgeVerdict_m.h"
+#include "veins/modules/mac/ieee80211p/Mac1609_4.h"
+#include "veins/modules/phy/DeciderResult80211.h"
+#include "veins/base/phyLayer/PhyToMacControlInfo.h"
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+#include <chrono>
 #include <random>
 #include <cmath>
 #include <algorithm>
@@ -7,322 +16,578 @@
 
 using namespace veins;
 
+namespace {
+
+// Forged sender IDs are handed out from here on, above the module IDs of any
+// run this scenario makes
+const int forgedIdBase = 1 << 20;
+
+} // namespace
+
 // Static member initialization
 std::map<long, DeliveryInfo> MyVeinsApp::globalPacketMap;
 long MyVeinsApp::nextPacketId = 1;
+std::set<int> MyVeinsApp::maliciousNodes;
+int MyVeinsApp::nextForgedId = forgedIdBase;
+std::map<int, AttackerTimeline> MyVeinsApp::attackerTimelines;
+DetectionCounts MyVeinsApp::networkDetectionCounts;
+QuantileSketch MyVeinsApp::networkDelaySketch;
+QuantileSketch MyVeinsApp::networkJitterSketch;
+QuantileSketch MyVeinsApp::networkInterArrivalSketch;
+bool MyVeinsApp::runListenerAdded = false;
+bool MyVeinsApp::runHasApps = false;
+std::string MyVeinsApp::runProfileFile;
+std::string MyVeinsApp::runSaveStateFile;
+DetectionTraceWriter MyVeinsApp::traceWriter;
+AppStateStore MyVeinsApp::savedState;
+AppStateStore MyVeinsApp::loadedState;
+std::string MyVeinsApp::loadedStateFile;
+const simsignal_t MyVeinsApp::channelBusySignal = registerSignal("org_car2x_veins_modules_mac_sigChannelBusy");
 
 Define_Module(veins::MyVeinsApp);
 
-// ==================== ENHANCED FLOOD ATTACK PREVENTION ====================
-
-bool MyVeinsApp::isFloodAttacker(int senderId) {
-    auto it = messageCounters.find(senderId);
-    if (it == messageCounters.end()) {
-        return false;
+#ifdef V2V_PROFILE_STAGES
+namespace {
+
+// Brackets every TraCI step (SUMO round trip and mobility updates) as a
+// profiler stage; subscribed once for all apps
+class TraciStepProfiler : public cListener {
+public:
+    void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override {
+        if (signalID == TraCIScenarioManager::traciTimestepBeginSignal && !inStep) {
+            V2V_PROFILE_BEGIN("traciStep");
+            inStep = true;
+        } else if (signalID == TraCIScenarioManager::traciTimestepEndSignal && inStep) {
+            V2V_PROFILE_END();
+            inStep = false;
+        }
     }
 
-    MessageCounter& counter = it->second;
-    simtime_t currentTime = simTime();
+private:
+    bool inStep = false;
+};
 
-    // Enhanced window management with sliding window
-    if (currentTime - counter.startTime > detectionWindow) {
-        // Slide the window - keep recent data for better detection
-        if (counter.messageTimestamps.size() > 0) {
-            // Remove old timestamps outside current window
-            auto oldThreshold = currentTime - detectionWindow;
-            while (!counter.messageTimestamps.empty() &&
-                   counter.messageTimestamps.front() < oldThreshold) {
-                counter.messageTimestamps.pop_front();
-                counter.count = counter.messageTimestamps.size();
-            }
-            counter.startTime = counter.messageTimestamps.empty() ?
-                               currentTime : counter.messageTimestamps.front();
-        } else {
-            counter.count = 0;
-            counter.startTime = currentTime;
+TraciStepProfiler traciStepProfiler;
+
+} // namespace
+#endif
+
+namespace {
+
+// Vehicles finish whenever they leave the scenario, and the fleet may empty
+// out mid-run, so the network-wide output is written once per run after the
+// network has finished instead of by whichever app happens to finish last
+class RunFinishListener : public cISimulationLifecycleListener {
+public:
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject* details) override {
+        if (eventType == LF_POST_NETWORK_FINISH) {
+            MyVeinsApp::finishRun(getSimulation()->getSystemModule());
         }
-        counter.isBlacklisted = false; // Give another chance after cleanup
     }
+    void listenerRemoved() override {}             // Static, never deleted
+};
+
+RunFinishListener runFinishListener;
+
+} // namespace
+
+// ==================== DETECTOR GLUE ====================
+
+ReceptionEvent MyVeinsApp::makeReceptionEvent(MyMsg* msg) const {
+    ReceptionEvent ev;
+    ev.receiverId = getParentModule()->getId();
+    ev.senderId = msg->getSrcId();
+    ev.time = simTime().dbl();
+    ev.posX = msg->getSenderPosX();
+    ev.posY = msg->getSenderPosY();
+    ev.speedX = msg->getSenderSpeedX();
+    ev.speedY = msg->getSenderSpeedY();
+    ev.timestamp = msg->getTimestamp().dbl();
+    return ev;
+}
 
-    // Multi-level threshold detection
-    if (counter.count > severeFloodThreshold) {
-        // Severe flooding - immediate blacklist
-        counter.isBlacklisted = true;
-        counter.blacklistTime = currentTime;
-        EV_WARN << "SEVERE FLOOD ATTACK DETECTED: " << senderId
-                << " | Rate: " << counter.count << " msgs/sec"
-                << " | Threshold: " << severeFloodThreshold << endl;
-        return true;
-    }
-    else if (counter.count > floodThreshold) {
-        // Moderate flooding - check persistence
-        if (counter.suspicionStartTime == -1) {
-            counter.suspicionStartTime = currentTime;
+double MyVeinsApp::receivedPower(cMessage* msg) const {
+    // Mac1609_4 hands the PHY's decider result up with every frame
+    if (auto controlInfo = dynamic_cast<PhyToMacControlInfo*>(msg->getControlInfo())) {
+        if (auto result = dynamic_cast<DeciderResult80211*>(controlInfo->getDeciderResult())) {
+            return result->getRecvPower_dBm();
         }
+    }
+    return std::nan("");
+}
 
-        simtime_t suspicionDuration = currentTime - counter.suspicionStartTime;
-        if (suspicionDuration > persistentFloodDuration) {
-            counter.isBlacklisted = true;
-            counter.blacklistTime = currentTime;
+void MyVeinsApp::logDetection(int senderId, const DetectionResult& result) {
+    if (result.verdict == DetectionVerdict::Blocked) {
+        if (result.reason == DetectionReason::SevereFlood) {
+            EV_WARN << "SEVERE FLOOD ATTACK DETECTED: " << senderId
+                    << " | Rate: " << result.rate << " msgs/sec"
+                    << " | Threshold: " << detectorParams.severeFloodThreshold << endl;
+        }
+        else if (result.reason == DetectionReason::PersistentFlood) {
             EV_WARN << "PERSISTENT FLOOD ATTACK DETECTED: " << senderId
-                    << " | Rate: " << counter.count << " msgs/sec"
-                    << " | Duration: " << suspicionDuration << "s" << endl;
-            return true;
+                    << " | Rate: " << result.rate << " msgs/sec"
+                    << " | Duration: " << result.duration << "s" << endl;
         }
-        return false; // Not blacklisted yet, but suspicious
+        EV_WARN << "DROPPED PACKET from blacklisted flood attacker: " << senderId << endl;
+        return;
     }
-    else {
-        // Normal rate - reset suspicion
-        counter.suspicionStartTime = -1;
-        return counter.isBlacklisted; // Return current blacklist status
+
+    if (result.reason == DetectionReason::SybilIdentity) {
+        EV_WARN << "Sybil identity: " << senderId
+                << " | Correlated identities: " << sybilDetector.clusterSize(senderId) << endl;
     }
-}
 
-void MyVeinsApp::updateMessageCounter(int senderId) {
-    auto it = messageCounters.find(senderId);
-    simtime_t currentTime = simTime();
+    if (result.reason == DetectionReason::InvalidContent) {
+        EV_WARN << "Message validation failed for sender: " << senderId
+                << " (" << contentCheckName(result.content) << ")" << endl;
+    }
 
-    if (it == messageCounters.end()) {
-        // First message from this sender
-        MessageCounter counter;
-        counter.count = 1;
-        counter.startTime = currentTime;
-        counter.suspicionStartTime = -1;
-        counter.isBlacklisted = false;
-        counter.blacklistTime = -1;
-        counter.messageTimestamps.push_back(currentTime);
-        messageCounters[senderId] = counter;
+    // Log detailed detection information
+    EV_WARN << "MALICIOUS BEHAVIOR DETECTED: " << senderId
+            << " | Reason: " << detectionReasonName(result.reason)
+            << " | Rate: " << result.rate << " msgs/sec"
+            << " | Total detections: " << attacksDetected << endl;
+}
 
-        EV_DEBUG << "New sender registered: " << senderId << endl;
-    } else {
-        MessageCounter& counter = it->second;
-
-        // Check if blacklist period has expired
-        if (counter.isBlacklisted && (currentTime - counter.blacklistTime > blacklistTimeout)) {
-            EV_INFO << "Blacklist expired for sender: " << senderId << endl;
-            counter.isBlacklisted = false;
-            counter.count = 0;
-            counter.startTime = currentTime;
-            counter.suspicionStartTime = -1;
-            counter.messageTimestamps.clear();
-        }
-
-        if (!counter.isBlacklisted) {
-            // Add current timestamp and maintain sliding window
-            counter.messageTimestamps.push_back(currentTime);
-            counter.count = counter.messageTimestamps.size();
-
-            // Remove timestamps outside the detection window
-            auto oldThreshold = currentTime - detectionWindow;
-            while (!counter.messageTimestamps.empty() &&
-                   counter.messageTimestamps.front() < oldThreshold) {
-                counter.messageTimestamps.pop_front();
-                counter.count = counter.messageTimestamps.size();
-            }
+// ==================== DETECTION ACCURACY ====================
 
-            // Update start time if window was empty
-            if (counter.messageTimestamps.empty()) {
-                counter.startTime = currentTime;
-            }
+void MyVeinsApp::recordDetectionMetrics(int senderId, const DetectionResult& result, simtime_t now) {
+    bool senderMalicious = maliciousNodes.count(senderId) > 0;
+    MetricsUpdate update = detectionMetrics.observe(senderId, senderMalicious, result,
+                                                    detector.isBlacklisted(senderId), now.dbl());
 
-            // Calculate current message rate for logging
-            double currentRate = counter.count / detectionWindow;
-            if (currentRate > floodThreshold * 0.8) { // Log when approaching threshold
-                EV_DEBUG << "Sender " << senderId << " rate: " << currentRate
-                         << " msgs/sec" << endl;
-            }
+    if (update.falsePositive) {
+        detectionStats.falsePositives++;
+        falsePositiveVector.record(detectionStats.falsePositives);
+    }
+    if (update.timeToDetect >= 0) {
+        timeToDetectHistogram.collect(update.timeToDetect);
+        detectionRateVector.record(detectionMetrics.getCounts().recall());
+    }
+    if (update.blacklistDwell >= 0) {
+        blacklistDwellHistogram.collect(update.blacklistDwell);
+    }
+
+    // Network-wide per-attacker timeline
+    if (senderMalicious) {
+        AttackerTimeline& timeline = attackerTimelines[senderId];
+        if (timeline.firstHeard < 0) {
+            timeline.firstHeard = now;
+        }
+        if (result.verdict != DetectionVerdict::Accepted && timeline.firstDetected < 0) {
+            timeline.firstDetected = now;
         }
     }
 }
 
-// ==================== ENHANCED DETECTION ALGORITHMS ====================
+void MyVeinsApp::recordNetworkDetectionMetrics(cComponent* target) {
+    EV_STATICCONTEXT;
+    cHistogram attackerTimeToDetect("networkTimeToDetect");
+    int attackersDetected = 0;
+    for (const auto& entry : attackerTimelines) {
+        const AttackerTimeline& timeline = entry.second;
+        if (timeline.firstDetected >= 0) {
+            attackersDetected++;
+            attackerTimeToDetect.collect(timeline.firstDetected - timeline.firstHeard);
+        }
+    }
 
-bool MyVeinsApp::detectMaliciousBehavior(MyMsg* msg) {
-    bool detected = false;
-    int senderId = msg->getSrcId();
-    std::string detectionReason;
+    const DetectionCounts& counts = networkDetectionCounts;
+    EV_INFO << "=== NETWORK DETECTION ACCURACY ===" << endl;
+    EV_INFO << "Precision: " << counts.precision() * 100 << "%" << endl;
+    EV_INFO << "Recall: " << counts.recall() * 100 << "%" << endl;
+    EV_INFO << "False Positive Rate: " << counts.falsePositiveRate() * 100 << "%" << endl;
+    EV_INFO << "Attackers Detected: " << attackersDetected << " of " << attackerTimelines.size() << endl;
+
+    target->recordScalar("networkPrecision", counts.precision());
+    target->recordScalar("networkRecall", counts.recall());
+    target->recordScalar("networkFalsePositiveRate", counts.falsePositiveRate());
+    target->recordScalar("networkTruePositives", counts.truePositives);
+    target->recordScalar("networkFalsePositives", counts.falsePositives);
+    target->recordScalar("networkAttackersDetected", attackersDetected);
+    target->recordScalar("networkAttackersHeard", attackerTimelines.size());
+    target->recordStatistic(&attackerTimeToDetect, "s");
+
+    networkDetectionCounts = DetectionCounts();
+    attackerTimelines.clear();
+    maliciousNodes.clear();
+    nextForgedId = forgedIdBase;
+}
 
-    // ========== ENHANCED FLOOD/DOS DETECTION ==========
-    auto counterIt = messageCounters.find(senderId);
-    if (counterIt != messageCounters.end()) {
-        MessageCounter& counter = counterIt->second;
-        double currentRate = counter.count / detectionWindow;
+// ==================== SENDER TABLE MAINTENANCE ====================
 
-        // Multi-level flood detection
-        if (currentRate > severeFloodThreshold) {
-            detected = true;
-            std::ostringstream oss;
-            oss << "Severe flooding (" << currentRate << " msgs/sec)";
-            detectionReason = oss.str();
-            counter.isBlacklisted = true;
-            counter.blacklistTime = simTime();
-        }
-        else if (currentRate > floodThreshold) {
-            // Check for burst detection
-            if (detectBurstAttack(counter)) {
-                detected = true;
-                detectionReason = "Burst attack detected";
-                counter.isBlacklisted = true;
-                counter.blacklistTime = simTime();
-            }
-            // Check for sustained high rate
-            else if (counter.suspicionStartTime != -1) {
-                simtime_t suspicionTime = simTime() - counter.suspicionStartTime;
-                if (suspicionTime > persistentFloodDuration) {
-                    detected = true;
-                    std::ostringstream oss;
-                    oss << "Sustained high rate for " << suspicionTime << "s";
-                    detectionReason = oss.str();
-                    counter.isBlacklisted = true;
-                    counter.blacklistTime = simTime();
-                }
-            }
-        }
+void MyVeinsApp::trackSender(int senderId) {
+    if (!senderWheelTimer) {
+        return;
+    }
+    const MessageCounter* counter = detector.findCounter(senderId);
+    if (!counter) {
+        return;
+    }
 
-        // Entropy-based anomaly detection
-        if (!detected && entropyBasedDetectionEnabled) {
-            if (detectAnomalousTraffic(senderId, currentRate)) {
-                detected = true;
-                detectionReason = "Anomalous traffic pattern";
-                counter.suspicionLevel++; // Increase suspicion level
-                if (counter.suspicionLevel > maxSuspicionLevel) {
-                    counter.isBlacklisted = true;
-                    counter.blacklistTime = simTime();
-                }
-            }
-        }
+    // After an idle period the wheel jumps straight to now, nothing can fire
+    if (senderWheel.empty()) {
+        senderWheel.advance(simTime().dbl(), [](int, int) {});
     }
 
-    // ========== MESSAGE CONTENT VALIDATION ==========
-    if (!detected && messageValidationEnabled) {
-        if (!validateMessageContent(msg)) {
-            detected = true;
-            detectionReason = "Invalid message content";
-            EV_WARN << "Message validation failed for sender: " << senderId << endl;
-        }
+    // Timers already pending re-check their sender when they fire, so a
+    // reception costs no cancel and reschedule
+    SenderTimers& timers = senderTimers[senderId];
+    if (counter->isBlacklisted && !senderWheel.isScheduled(timers.blacklistExpiry)) {
+        timers.blacklistExpiry = senderWheel.schedule(counter->blacklistTime + detectorParams.blacklistTimeout,
+                                                      senderId, BlacklistExpiry);
+    }
+    if (suspicionDecayInterval > 0 && counter->suspicionLevel > 0 && !senderWheel.isScheduled(timers.suspicionDecay)) {
+        timers.suspicionDecay = senderWheel.schedule(simTime().dbl() + suspicionDecayInterval.dbl(), senderId, SuspicionDecay);
+    }
+    if (senderIdleTimeout > 0 && !senderWheel.isScheduled(timers.idleEviction)) {
+        timers.idleEviction = senderWheel.schedule(counter->lastHeard + senderIdleTimeout.dbl(), senderId, IdleEviction);
     }
 
-    if (detected) {
-        attacksDetected++;
-        takeEvasiveAction();
+    if (!senderWheelTimer->isScheduled() && !senderWheel.empty()) {
+        double tick = senderWheel.getTickLength();
+        scheduleAt((std::floor(simTime().dbl() / tick) + 1) * tick, senderWheelTimer);
+    }
+}
 
-        // Log detailed detection information
-        EV_WARN << "MALICIOUS BEHAVIOR DETECTED: " << senderId
-                << " | Reason: " << detectionReason
-                << " | Total detections: " << attacksDetected << endl;
+void MyVeinsApp::runSenderWheel() {
+    senderWheel.advance(simTime().dbl(), [this](int senderId, int kind) {
+        onSenderTimer(senderId, kind);
+    });
+    if (!senderWheel.empty()) {
+        scheduleAt(simTime() + senderWheel.getTickLength(), senderWheelTimer);
+    }
+}
 
-        // Update detection statistics
-        detectionStats.totalDetections++;
-        if (counterIt != messageCounters.end()) {
-            detectionStats.highRateDetections++;
+void MyVeinsApp::onSenderTimer(int senderId, int kind) {
+    const MessageCounter* counter = detector.findCounter(senderId);
+    if (!counter) {
+        return;
+    }
+    SenderTimers& timers = senderTimers[senderId];
+    double now = simTime().dbl();
+    double blacklistEnd = counter->blacklistTime + detectorParams.blacklistTimeout;
+
+    switch (kind) {
+        case BlacklistExpiry:
+            if (detector.expireBlacklist(senderId, now)) {
+                blacklistsExpired++;
+                EV_INFO << "Blacklist of sender " << senderId << " expired" << endl;
+            } else if (counter->isBlacklisted) {
+                timers.blacklistExpiry = senderWheel.schedule(blacklistEnd, senderId, BlacklistExpiry);
+            }
+            break;
+
+        case SuspicionDecay:
+            detector.decaySuspicion(senderId);
+            suspicionDecays++;
+            if (counter->suspicionLevel > 0) {
+                timers.suspicionDecay = senderWheel.schedule(now + suspicionDecayInterval.dbl(), senderId, SuspicionDecay);
+            }
+            break;
+
+        case IdleEviction: {
+            // Blacklisted senders stay until the blacklist has run out
+            double idleEnd = counter->lastHeard + senderIdleTimeout.dbl();
+            if (counter->isBlacklisted) {
+                timers.idleEviction = senderWheel.schedule(std::max(idleEnd, blacklistEnd), senderId, IdleEviction);
+            } else if (now < idleEnd) {
+                timers.idleEviction = senderWheel.schedule(idleEnd, senderId, IdleEviction);
+            } else {
+                evictSender(senderId);
+            }
+            break;
         }
+    }
+}
 
-        return true;
+void MyVeinsApp::evictSender(int senderId) {
+    auto it = senderTimers.find(senderId);
+    if (it != senderTimers.end()) {
+        senderWheel.cancel(it->second.blacklistExpiry);
+        senderWheel.cancel(it->second.suspicionDecay);
+        senderWheel.cancel(it->second.idleEviction);
+        senderTimers.erase(it);
+    }
+    detector.erase(senderId);
+    lastReported.erase(senderId);
+    if (admissionFilter) {
+        admissionFilter->forget(senderId);
+    }
+    if (sybilDetection) {
+        sybilDetector.forget(senderId);
     }
+    sendersEvicted++;
+    EV_DEBUG << "Evicted idle sender " << senderId << endl;
+}
+
+// ==================== COOPERATIVE BLACKLIST ====================
 
-    return false;
+void MyVeinsApp::reportMisbehavior(int suspectId, const DetectionResult& result) {
+    auto it = lastReported.find(suspectId);
+    if (it != lastReported.end() && simTime() - it->second < reportInterval) {
+        return;
+    }
+    lastReported[suspectId] = simTime();
+
+    MisbehaviorReport* report = new MisbehaviorReport();
+    populateWSM(report);
+    report->setReporterId(getParentModule()->getId());
+    report->setSuspectId(suspectId);
+    report->setReason((int)result.reason);
+    report->setDetectedAt(simTime());
+    report->addByteLength(16);
+    sendDown(report);
+    reportsSent++;
+
+    EV_INFO << "Reporting misbehaviour of " << suspectId << " (" << detectionReasonName(result.reason) << ") to RSUs" << endl;
 }
 
-bool MyVeinsApp::detectBurstAttack(const MessageCounter& counter) {
-    if (counter.messageTimestamps.size() < minBurstSize) {
-        return false;
+void MyVeinsApp::onRevocationUpdate(RevocationUpdate* update) {
+    std::vector<uint8_t> payload(update->getPayloadArraySize());
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = update->getPayload(i);
     }
 
-    // Check for rapid succession of messages (burst)
-    auto recentStart = counter.messageTimestamps.end() - std::min((size_t)minBurstSize, counter.messageTimestamps.size());
-    simtime_t burstDuration = counter.messageTimestamps.back() - *recentStart;
+    uint64_t digest = revocationDigest(revocationKey, update->getIssuerId(), update->getFull(),
+                                       update->getBaseEpoch(), update->getEpoch(), payload);
+    if (digest != update->getSignature()) {
+        EV_WARN << "Dropping revocation update with invalid signature from " << update->getIssuerId() << endl;
+        revocationUpdatesRejected++;
+        return;
+    }
 
-    if (burstDuration < maxBurstDuration) {
-        double burstRate = minBurstSize / burstDuration.dbl();
-        EV_DEBUG << "Burst detected: rate=" << burstRate << " msgs/sec, duration=" << burstDuration << endl;
-        return burstRate > burstThreshold;
+    RevocationList& list = rsuRevocations[update->getIssuerId()];
+    if (!update->getFull() && update->getEpoch() <= list.getEpoch()) {
+        return; // Already have it
+    }
+    bool applied = update->getFull() ? list.applyFull(update->getEpoch(), payload)
+                                     : list.applyDelta(update->getBaseEpoch(), update->getEpoch(), payload);
+    if (!applied) {
+        // Missed a delta, wait for the next full list
+        revocationUpdatesRejected++;
+        return;
     }
+    revocationUpdatesApplied++;
 
-    return false;
+    revokedSenders.clear();
+    for (const auto& entry : rsuRevocations) {
+        revokedSenders.merge(entry.second.getBitmap());
+    }
+    EV_DEBUG << "Revocation list of RSU " << update->getIssuerId() << " at epoch " << list.getEpoch()
+             << " | Revoked senders: " << revokedSenders.count() << endl;
 }
 
-bool MyVeinsApp::detectAnomalousTraffic(int senderId, double currentRate) {
-    // Calculate average rate across all senders for comparison
-    double totalRate = 0.0;
-    int activeSenders = 0;
+// ==================== RSU EDGE DETECTION ====================
 
-    for (const auto& entry : messageCounters) {
-        if (!entry.second.isBlacklisted) {
-            double rate = entry.second.count / detectionWindow;
-            totalRate += rate;
-            activeSenders++;
-        }
+void MyVeinsApp::onEdgeVerdict(EdgeVerdict* verdict) {
+    SenderBitmap& flagged = rsuVerdicts[verdict->getRsuId()];
+    flagged.clear();
+    for (size_t i = 0; i < verdict->getSuspectsArraySize(); i++) {
+        flagged.set(verdict->getSuspects(i));
     }
+    rsuVerdictExpiry[verdict->getRsuId()] = simTime() + verdict->getValidFor();
 
-    if (activeSenders > 0) {
-        double averageRate = totalRate / activeSenders;
-        double rateDeviation = std::abs(currentRate - averageRate) / averageRate;
-
-        // If rate is significantly higher than network average
-        if (rateDeviation > anomalyThreshold) {
-            EV_DEBUG << "Anomalous traffic from " << senderId
-                     << ": rate=" << currentRate << ", avg=" << averageRate
-                     << ", deviation=" << rateDeviation << endl;
-            return true;
+    rsuFlaggedSenders = flagged;
+    for (const auto& entry : rsuVerdicts) {
+        if (entry.first != verdict->getRsuId() && rsuVerdictExpiry[entry.first] > simTime()) {
+            rsuFlaggedSenders.merge(entry.second);
         }
     }
-
-    return false;
 }
 
-bool MyVeinsApp::validateMessageContent(MyMsg* msg) {
-    // Validate position coordinates
-    double posX = msg->getSenderPosX();
-    double posY = msg->getSenderPosY();
+bool MyVeinsApp::inRsuCoverage() {
+    bool covered = false;
+    for (auto it = rsuVerdictExpiry.begin(); it != rsuVerdictExpiry.end();) {
+        if (it->second > simTime()) {
+            covered = true;
+            ++it;
+        } else {
+            // Left this RSU's cell, its verdicts no longer apply
+            rsuVerdicts.erase(it->first);
+            it = rsuVerdictExpiry.erase(it);
+            rsuFlaggedSenders.clear();
+            for (const auto& entry : rsuVerdicts) {
+                rsuFlaggedSenders.merge(entry.second);
+            }
+        }
+    }
+    return covered;
+}
 
-    if (std::isnan(posX) || std::isnan(posY) ||
-        std::isinf(posX) || std::isinf(posY)) {
-        EV_WARN << "Invalid position coordinates in message from " << msg->getSrcId() << endl;
-        return false;
+// ==================== CONGESTION CONTROL ====================
+
+void MyVeinsApp::initializeDcc() {
+    DccParams params;
+    std::string mode = par("dccMode").stdstringValue();
+    if (mode == "off") {
+        params.mode = DccMode::Off;
+    } else if (mode == "reactive") {
+        params.mode = DccMode::Reactive;
+    } else if (mode == "adaptive") {
+        params.mode = DccMode::Adaptive;
+    } else {
+        throw cRuntimeError("Unknown dccMode '%s', expected off, reactive or adaptive", mode.c_str());
+    }
+    if (params.mode == DccMode::Off) {
+        return;
     }
 
-    // Validate speed (reasonable vehicle speeds)
-    double speedX = msg->getSenderSpeedX();
-    double speedY = msg->getSenderSpeedY();
-    double speed = std::sqrt(speedX * speedX + speedY * speedY);
+    params.cbrThresholds = cStringTokenizer(par("dccCbrThresholds")).asDoubleVector();
+    params.beaconIntervals = cStringTokenizer(par("dccBeaconIntervals")).asDoubleVector();
+    params.txPowers = cStringTokenizer(par("dccTxPowers")).asDoubleVector();
+    params.relaxSamples = par("dccRelaxSamples");
+    params.cbrTarget = par("dccCbrTarget");
+    params.frameAirtime = par("dccFrameAirtime").doubleValue();
+    params.minBeaconInterval = par("dccMinBeaconInterval").doubleValue();
+    params.maxBeaconInterval = par("dccMaxBeaconInterval").doubleValue();
+    params.minTxPower = par("dccMinTxPower");
+    params.txPowerStep = par("dccTxPowerStep");
+    dccMeasurementInterval = par("dccMeasurementInterval");
+
+    dccMac = FindModule<Mac1609_4*>::findSubModule(getParentModule());
+    if (!dccMac) {
+        throw cRuntimeError("DCC needs a Mac1609_4 in the host to measure the channel busy ratio");
+    }
+    double defaultTxPower = dccMac->par("txPower").doubleValue();
 
-    if (speed > maxReasonableSpeed) {
-        EV_WARN << "Unreasonable speed in message from " << msg->getSrcId()
-                << ": " << speed << " m/s" << endl;
-        return false;
+    try {
+        dcc.configure(params, beaconInterval.dbl(), defaultTxPower, simTime().dbl());
+    }
+    catch (const std::invalid_argument& e) {
+        throw cRuntimeError("Invalid DCC configuration: %s", e.what());
     }
 
-    // Validate timestamp (not from future, not too old)
-    simtime_t msgTimestamp = msg->getTimestamp();
-    simtime_t currentTime = simTime();
+    dccMac->subscribe(channelBusySignal, this);
+    dccTimer = new cMessage("dccTimer");
+    scheduleAt(simTime() + dccMeasurementInterval, dccTimer);
 
-    if (msgTimestamp > currentTime) {
-        EV_WARN << "Future timestamp in message from " << msg->getSrcId() << endl;
-        return false;
+    cbrVector.setName("Channel Busy Ratio");
+    beaconIntervalVector.setName("Beacon Interval");
+    txPowerVector.setName("Tx Power");
+}
+
+void MyVeinsApp::receiveSignal(cComponent* source, simsignal_t signalID, bool b, cObject* details) {
+    Enter_Method_Silent();
+    if (signalID == channelBusySignal) {
+        dcc.channelBusy(b, simTime().dbl());
     }
+}
 
-    if (currentTime - msgTimestamp > maxMessageAge) {
-        EV_WARN << "Stale message from " << msg->getSrcId()
-                << ", age: " << (currentTime - msgTimestamp) << "s" << endl;
-        return false;
+void MyVeinsApp::runDcc() {
+    double cbr = dcc.measure(simTime().dbl());
+    cbrVector.record(cbr);
+
+    if (dcc.getState() != dccState) {
+        dccState = dcc.getState();
+        EV_INFO << "DCC state " << dccState << " | CBR: " << cbr
+                << " | Beacon interval: " << dcc.getBeaconInterval() << "s"
+                << " | Tx power: " << dcc.getTxPower() << "mW" << endl;
+    }
+    if (dcc.getTxPower() != currentTxPower) {
+        currentTxPower = dcc.getTxPower();
+        dccMac->setTxPower(currentTxPower);
+        txPowerVector.record(currentTxPower);
+    }
+    if (dcc.getBeaconInterval() != currentBeaconInterval) {
+        currentBeaconInterval = dcc.getBeaconInterval();
+        beaconIntervalVector.record(currentBeaconInterval);
     }
 
-    return true;
+    scheduleAt(simTime() + dccMeasurementInterval, dccTimer);
+}
+
+simtime_t MyVeinsApp::nextBeaconInterval() const {
+    return dcc.isEnabled() ? SimTime(dcc.getBeaconInterval()) : beaconInterval;
 }
 
 // ==================== ENHANCED handleLowerMsg ====================
 
 void MyVeinsApp::handleLowerMsg(cMessage* msg) {
+    V2V_PROFILE_SCOPE("app.receive");
+    if (!admissionFilter) {
+        processLowerMsg(msg);
+        return;
+    }
+
+    // Tell the filter what a frame costs us, to estimate what dropping it saves
+    auto processingStart = std::chrono::steady_clock::now();
+    processLowerMsg(msg);
+    std::chrono::duration<double> processingCost = std::chrono::steady_clock::now() - processingStart;
+    admissionFilter->reportProcessingCost(processingCost.count());
+}
+
+void MyVeinsApp::processLowerMsg(cMessage* msg) {
+    if (auto update = dynamic_cast<RevocationUpdate*>(msg)) {
+        if (cooperativeBlacklist) {
+            onRevocationUpdate(update);
+        }
+        delete msg;
+        return;
+    }
+
+    if (auto verdict = dynamic_cast<EdgeVerdict*>(msg)) {
+        if (trustRsuVerdicts) {
+            onEdgeVerdict(verdict);
+        }
+        delete msg;
+        return;
+    }
+
     if (auto myMsg = dynamic_cast<veins::MyMsg*>(msg)) {
         int receiverId = getParentModule()->getId();
         long packetId = myMsg->getPacketId();
         int senderId = myMsg->getSrcId();
 
+        ReceptionEvent ev = makeReceptionEvent(myMsg);
+        if (tracing) {
+            traceWriter.writeReception(ev);
+        }
+
+        // Already revoked by the RSUs, skip local detection altogether
+        if (revokedSenders.test(senderId)) {
+            packetsDroppedRevoked++;
+            delete msg;
+            return;
+        }
+
+        // In RSU coverage the RSU's edge detector has already judged this sender
+        bool offloaded = trustRsuVerdicts && inRsuCoverage();
+        if (offloaded && rsuFlaggedSenders.test(senderId)) {
+            packetsDroppedByRsu++;
+            delete msg;
+            return;
+        }
+
         // ENHANCED FLOOD PREVENTION with multiple checks
-        if (!malicious && detectionEnabled) {
-            // Check blacklist first
-            if (isFloodAttacker(senderId)) {
-                EV_WARN << "DROPPED PACKET from blacklisted flood attacker: " << senderId << endl;
+        if (offloaded) {
+            detectionOffloaded++;
+        } else if (!malicious && detectionEnabled) {
+            DetectionResult result;
+            {
+                V2V_PROFILE_SCOPE("detection");
+                result = detector.inspect(ev);
+                trackSender(senderId);
+                if (sybilDetection && sybilDetector.observe(ev, receivedPower(msg))
+                        && result.verdict == DetectionVerdict::Accepted) {
+                    result.verdict = DetectionVerdict::Detected;
+                    result.reason = DetectionReason::SybilIdentity;
+                    sybilDetections++;
+                }
+            }
+            recordDetectionMetrics(senderId, result, simTime());
+
+            // Keep further frames of a blacklisted sender out of the application
+            // The filter's block ends together with the detector's blacklist entry
+            if (admissionFilter && detector.isBlacklisted(senderId)) {
+                admissionFilter->block(senderId, detector.findCounter(senderId)->blacklistTime + detectorParams.blacklistTimeout);
+            }
+            if (cooperativeBlacklist && detector.isBlacklisted(senderId)) {
+                reportMisbehavior(senderId, result);
+            }
+
+            if (result.verdict == DetectionVerdict::Blocked) {
+                logDetection(senderId, result);
                 detectionStats.packetsBlocked++;
                 attacksDetected++;
                 takeEvasiveAction();
@@ -330,40 +595,48 @@ void MyVeinsApp::handleLowerMsg(cMessage* msg) {
                 return;
             }
 
-            // Update counter and check for new attacks
-            updateMessageCounter(senderId);
+            if (result.verdict == DetectionVerdict::Detected) {
+                attacksDetected++;
+                takeEvasiveAction();
+                logDetection(senderId, result);
 
-            // Comprehensive malicious behavior detection
-            if (detectMaliciousBehavior(myMsg)) {
+                // Update detection statistics
+                detectionStats.totalDetections++;
+                detectionStats.highRateDetections++;
                 delete msg;
                 return;
             }
         } else {
             // Still update counters even if detection is disabled
-            updateMessageCounter(senderId);
+            detector.updateMessageCounter(senderId, ev.time);
+            trackSender(senderId);
         }
 
         // ========== UPDATE GLOBAL DELIVERY INFO ==========
-        auto it = globalPacketMap.find(packetId);
-        if (it != globalPacketMap.end()) {
-            // Packet exists in global map - add this receiver
-            it->second.receivers.insert(receiverId);
-            EV_DEBUG << "Updated delivery info for packet " << packetId
-                     << " | Receiver: " << receiverId
-                     << " | Total receivers: " << it->second.receivers.size() << endl;
-        } else {
-            // This shouldn't happen normally, but handle gracefully
-            EV_INFO << "Received packet " << packetId << " not found in global delivery map" << endl;
-            // Optionally create a new entry if packet wasn't tracked
-            DeliveryInfo info;
-            info.srcId = senderId;
-            info.sendTime = myMsg->getTimestamp();
-            info.receivers.insert(receiverId);
-            globalPacketMap[packetId] = info;
+        {
+            V2V_PROFILE_SCOPE("ledger");
+            auto it = globalPacketMap.find(packetId);
+            if (it != globalPacketMap.end()) {
+                // Packet exists in global map - add this receiver
+                it->second.receivers.insert(receiverId);
+                EV_DEBUG << "Updated delivery info for packet " << packetId
+                         << " | Receiver: " << receiverId
+                         << " | Total receivers: " << it->second.receivers.size() << endl;
+            } else {
+                // This shouldn't happen normally, but handle gracefully
+                EV_INFO << "Received packet " << packetId << " not found in global delivery map" << endl;
+                // Optionally create a new entry if packet wasn't tracked
+                DeliveryInfo info;
+                info.srcId = senderId;
+                info.sendTime = myMsg->getTimestamp();
+                info.receivers.insert(receiverId);
+                globalPacketMap[packetId] = info;
+            }
         }
         // ========== END GLOBAL DELIVERY UPDATE ==========
 
         // Count all packets received
+        V2V_PROFILE_SCOPE("statistics");
         packetsReceived++;
         packetsInWindow++;
 
@@ -386,6 +659,20 @@ void MyVeinsApp::handleLowerMsg(cMessage* msg) {
         }
         lastArrivalTime = currentArrivalTime;
 
+        // Quantiles of legitimate traffic only, a flood would dominate them
+        if (!maliciousNodes.count(senderId)) {
+            delaySketch.add(endToEndDelay.dbl());
+            if (lastLegitimateArrival != -1) {
+                simtime_t interArrivalTime = currentArrivalTime - lastLegitimateArrival;
+                interArrivalSketch.add(interArrivalTime.dbl());
+                if (lastLegitimateInterArrival != -1) {
+                    jitterSketch.add(std::fabs((interArrivalTime - lastLegitimateInterArrival).dbl()));
+                }
+                lastLegitimateInterArrival = interArrivalTime;
+            }
+            lastLegitimateArrival = currentArrivalTime;
+        }
+
         // Log reception details (optional - can be verbose)
         if (packetsReceived % 20 == 0) { // Log every 20th packet to reduce spam
             EV_INFO << "Received MyMsg #" << packetsReceived
@@ -450,29 +737,103 @@ void MyVeinsApp::initialize(int stage) {
         malicious = par("malicious");
         attackType = par("attackType").stdstringValue();
 
+        if (getParentModule()->getId() >= forgedIdBase) {
+            throw cRuntimeError("Module ID %d reaches the forged sender IDs from %d", getParentModule()->getId(), forgedIdBase);
+        }
+
+        // Ground truth for accuracy metrics
+        if (malicious) {
+            maliciousNodes.insert(getParentModule()->getId());
+        }
+        if (!runListenerAdded) {
+            getEnvir()->addLifecycleListener(&runFinishListener);
+            runListenerAdded = true;
+        }
+        runHasApps = true;
+        runProfileFile = par("profileFile").stdstringValue();
+        runSaveStateFile = par("saveStateFile").stdstringValue();
+#ifdef V2V_PROFILE_STAGES
+        if (!getSystemModule()->isSubscribed(TraCIScenarioManager::traciTimestepBeginSignal, &traciStepProfiler)) {
+            getSystemModule()->subscribe(TraCIScenarioManager::traciTimestepBeginSignal, &traciStepProfiler);
+            getSystemModule()->subscribe(TraCIScenarioManager::traciTimestepEndSignal, &traciStepProfiler);
+        }
+#endif
+
         // Enhanced detection parameters
-        floodThreshold = par("floodThreshold");
-        severeFloodThreshold = par("severeFloodThreshold");
-        burstThreshold = par("burstThreshold");
-        anomalyThreshold = par("anomalyThreshold");
-        detectionWindow = par("detectionWindow");
-        blacklistTimeout = par("blacklistTimeout");
-        persistentFloodDuration = par("persistentFloodDuration");
-        maxBurstDuration = par("maxBurstDuration");
-        minBurstSize = par("minBurstSize");
-        maxReasonableSpeed = par("maxReasonableSpeed");
-        maxMessageAge = par("maxMessageAge");
-        maxSuspicionLevel = par("maxSuspicionLevel");
+        detectorParams.floodThreshold = par("floodThreshold");
+        detectorParams.severeFloodThreshold = par("severeFloodThreshold");
+        detectorParams.burstThreshold = par("burstThreshold");
+        detectorParams.anomalyThreshold = par("anomalyThreshold");
+        detectorParams.detectionWindow = par("detectionWindow").doubleValue();
+        detectorParams.blacklistTimeout = par("blacklistTimeout").doubleValue();
+        detectorParams.persistentFloodDuration = par("persistentFloodDuration").doubleValue();
+        detectorParams.maxBurstDuration = par("maxBurstDuration").doubleValue();
+        detectorParams.minBurstSize = par("minBurstSize");
+        detectorParams.maxReasonableSpeed = par("maxReasonableSpeed");
+        detectorParams.maxMessageAge = par("maxMessageAge").doubleValue();
+        detectorParams.maxSuspicionLevel = par("maxSuspicionLevel");
 
         // Detection features
         detectionEnabled = par("detectionEnabled");
-        entropyBasedDetectionEnabled = par("entropyBasedDetection");
-        messageValidationEnabled = par("messageValidation");
+        detectorParams.entropyBasedDetection = par("entropyBasedDetection");
+        detectorParams.messageValidation = par("messageValidation");
+        detector.setParams(detectorParams);
+
+        // Blacklist expiry, suspicion decay and idle eviction on a timing wheel
+        double senderTimerTick = par("senderTimerTick").doubleValue();
+        senderIdleTimeout = par("senderIdleTimeout");
+        suspicionDecayInterval = par("suspicionDecayInterval");
+        if (senderTimerTick > 0) {
+            if (senderIdleTimeout > 0 && senderIdleTimeout.dbl() < detectorParams.detectionWindow) {
+                throw cRuntimeError("senderIdleTimeout must not be shorter than detectionWindow");
+            }
+            senderWheel.setTickLength(senderTimerTick);
+            senderWheelTimer = new cMessage("senderWheelTimer");
+        }
+
+        sybilDetection = par("sybilDetection");
+        if (sybilDetection) {
+            SybilParams sybilParams;
+            sybilParams.positionRadius = par("sybilPositionRadius");
+            sybilParams.timingTolerance = par("sybilTimingTolerance").doubleValue();
+            sybilParams.rssiTolerance = par("sybilRssiTolerance").doubleValue();
+            sybilParams.minCoincidences = par("sybilMinCoincidences");
+            sybilParams.minClusterSize = par("sybilMinClusterSize");
+            sybilParams.evidenceTimeout = par("sybilEvidenceTimeout").doubleValue();
+            try {
+                sybilDetector.setParams(sybilParams);
+            }
+            catch (const std::invalid_argument& e) {
+                throw cRuntimeError("Invalid Sybil detection configuration: %s", e.what());
+            }
+        }
+
+        if (malicious) {
+            initializeAttack();
+        }
+
+        // Optional detector input trace for offline threshold tuning
+        std::string traceFile = par("traceFile").stdstringValue();
+        if (!traceFile.empty()) {
+            if (!traceWriter.isOpen() && !traceWriter.open(traceFile)) {
+                throw cRuntimeError("Cannot open detection trace file '%s'", traceFile.c_str());
+            }
+            traceWriter.writeNode(getParentModule()->getId(), malicious);
+            if (attackModel) {
+                for (int id : attackModel->identityIds(getParentModule()->getId())) {
+                    if (id != getParentModule()->getId()) {
+                        traceWriter.writeNode(id, true);
+                    }
+                }
+            }
+            tracing = !malicious;
+        }
 
         EV_INFO << "Enhanced attack detection: " << (detectionEnabled ? "ENABLED" : "DISABLED") << endl;
         if (detectionEnabled) {
-            EV_INFO << "Entropy-based detection: " << (entropyBasedDetectionEnabled ? "ON" : "OFF") << endl;
-            EV_INFO << "Message validation: " << (messageValidationEnabled ? "ON" : "OFF") << endl;
+            EV_INFO << "Entropy-based detection: " << (detectorParams.entropyBasedDetection ? "ON" : "OFF") << endl;
+            EV_INFO << "Message validation: " << (detectorParams.messageValidation ? "ON" : "OFF") << endl;
+            EV_INFO << "Sybil detection: " << (sybilDetection ? "ON" : "OFF") << endl;
         }
 
         // Initialize detection statistics
@@ -497,6 +858,8 @@ void MyVeinsApp::initialize(int stage) {
         packetsSent = 0;
         lastArrivalTime = -1;
         lastInterArrivalTime = -1;
+        lastLegitimateArrival = -1;
+        lastLegitimateInterArrival = -1;
         lastThroughputTime = simTime();
 
         lastWindowStart = simTime();
@@ -510,10 +873,53 @@ void MyVeinsApp::initialize(int stage) {
         throughputVector.setName("Throughput");
         detectionRateVector.setName("Detection Rate");
         falsePositiveVector.setName("False Positives");
+        simtime_t vectorAggregationInterval = par("vectorAggregationInterval");
+        packetsSentVector.setInterval(vectorAggregationInterval);
+        endToEndDelayVector.setInterval(vectorAggregationInterval);
+        jitterVector.setInterval(vectorAggregationInterval);
+        timeToDetectHistogram.setName("timeToDetect");
+        blacklistDwellHistogram.setName("blacklistDwell");
+
+        beaconJitter = par("beaconJitter");
+        if (sybilDetection && beaconJitter == SIMTIME_ZERO) {
+            EV_WARN << "Sybil detection without beaconJitter: vehicles beaconing in phase look like Sybil identities" << endl;
+        }
+        initializeDcc();
+
+        batchTraciCommands = par("batchTraciCommands");
+        if (batchTraciCommands) {
+            signalManager.subscribeCallback(getSystemModule(), TraCIScenarioManager::traciTimestepBeginSignal, [this](SignalPayload<const simtime_t&> payload) {
+                flushTraciCommands();
+            });
+        }
+
+        admissionFilter = FindModule<AdmissionFilter*>::findSubModule(getParentModule());
+
+        cooperativeBlacklist = par("cooperativeBlacklist");
+        reportInterval = par("reportInterval");
+        revocationKey = par("revocationKey").intValue();
+        trustRsuVerdicts = par("trustRsuVerdicts");
+
+        // Warm start: continue from the counters this vehicle had at the end of the warm-up run
+        std::string loadStateFile = par("loadStateFile").stdstringValue();
+        if (!loadStateFile.empty() && mobility) {
+            if (loadStateFile != loadedStateFile) {
+                if (!loadedState.load(loadStateFile)) {
+                    throw cRuntimeError("Cannot load app state file '%s'", loadStateFile.c_str());
+                }
+                loadedStateFile = loadStateFile;
+                EV_INFO << "Loaded app state of " << loadedState.size() << " vehicles from " << loadStateFile << endl;
+            }
+            if (const AppCounters* saved = loadedState.find(mobility->getExternalId())) {
+                restoreCounters(*saved);
+            }
+        }
 
         if (malicious) {
-            attackTimer = new cMessage("attackTimer");
-            scheduleAt(simTime() + par("attackInterval").doubleValue(), attackTimer);
+            if (attackModel) {
+                attackTimer = new cMessage("attackTimer");
+                scheduleAt(simTime() + attackModel->nextTick(simTime().dbl()), attackTimer);
+            }
             EV_INFO << "MALICIOUS NODE: " << getParentModule()->getFullName()
                     << " | Attack type: " << attackType << endl;
             changeNodeColor("red");
@@ -526,6 +932,55 @@ void MyVeinsApp::initialize(int stage) {
     }
 }
 
+void MyVeinsApp::initializeAttack() {
+    if (attackType == "none") {
+        return;
+    }
+
+    AttackParams params;
+    params.interval = par("attackInterval").doubleValue();
+    params.burstSize = par("attackBurstSize");
+    params.rateProfile = par("attackRateProfile").stdstringValue();
+    params.rampDuration = par("attackRampDuration").doubleValue();
+    params.rampFactor = par("attackRampFactor");
+    params.onTime = par("attackOnTime").doubleValue();
+    params.offTime = par("attackOffTime").doubleValue();
+    params.identities = par("attackIdentities");
+    params.evasion = par("attackEvasion");
+    params.firstForgedId = nextForgedId;
+    nextForgedId += params.identities - 1;
+    params.evasionThreshold = par("attackEvasionThreshold");
+    params.evasionWindow = detectorParams.detectionWindow;
+    params.evasionMargin = par("attackEvasionMargin");
+    params.floodSpeed = par("attackFloodSpeed");
+    params.spoofX = par("attackSpoofX");
+    params.spoofY = par("attackSpoofY");
+    params.replayOffset = par("attackReplayOffset");
+    params.replaySpeed = par("attackReplaySpeed");
+    params.replayAge = par("attackReplayAge").doubleValue();
+    params.sybilSpacing = par("attackSybilSpacing");
+
+    try {
+        attackModel = AttackModelRegistry::create(attackType, params);
+    }
+    catch (const std::invalid_argument& e) {
+        throw cRuntimeError("Invalid attack configuration: %s", e.what());
+    }
+    if (!attackModel) {
+        std::string known;
+        for (const std::string& name : AttackModelRegistry::getNames()) {
+            known += " " + name;
+        }
+        throw cRuntimeError("Unknown attackType '%s', known attack models:%s", attackType.c_str(), known.c_str());
+    }
+    attackModel->seed(getRNG(0)->intRand());
+
+    // Forged identities are attackers too, for the ground truth
+    for (int id : attackModel->identityIds(getParentModule()->getId())) {
+        maliciousNodes.insert(id);
+    }
+}
+
 void MyVeinsApp::changeNodeColor(const char* color) {
     cDisplayString& dispStr = getParentModule()->getDisplayString();
     dispStr.setTagArg("i", 1, color);
@@ -558,76 +1013,72 @@ void MyVeinsApp::onWSM(BaseFrame1609_4* wsm) {
 }
 
 void MyVeinsApp::handleSelfMsg(cMessage* msg) {
+    V2V_PROFILE_SCOPE("app.timer");
     if (msg == attackTimer && malicious) {
         attackCounter++;
 
-        if (attackType == "flood") {
-            for (int i = 0; i < 5; i++) {
-                // Use MyMsg instead of DemoSafetyMessage for attacks
-                MyMsg* floodMsg = new MyMsg();
-                populateMyMsg(floodMsg , true);
-                // Set unrealistic speed using custom fields
-                floodMsg->setSenderSpeedX(150 + i);
-                floodMsg->setSenderSpeedY(0);
-                sendDown(floodMsg);
-                attackPacketsSent++;
-                packetsSent++;
-                packetsSentVector.record(packetsSent);
-            }
-            EV_INFO << "FLOOD ATTACK #" << attackCounter << " sent by "
-                    << getParentModule()->getFullName() << endl;
-
-        } else if (attackType == "spoof") {
-            MyMsg* spoofMsg = new MyMsg();
-            populateMyMsg(spoofMsg , true);
-            // Set impossible location using custom fields
-            spoofMsg->setSenderPosX(7000);
-            spoofMsg->setSenderPosY(7000);
-            spoofMsg->setSenderSpeedX(0);
-            spoofMsg->setSenderSpeedY(0);
-            sendDown(spoofMsg);
+        AttackerState self;
+        self.ownId = getParentModule()->getId();
+        self.now = simTime().dbl();
+        self.posX = curPosition.x;
+        self.posY = curPosition.y;
+        self.speedX = curSpeed.x;
+        self.speedY = curSpeed.y;
+        forgedBeacons.clear();
+        attackModel->tick(self, forgedBeacons);
+
+        for (const ForgedBeacon& forged : forgedBeacons) {
+            MyMsg* attackMsg = new MyMsg();
+            populateMyMsg(attackMsg , true);
+            // Claimed identity, kinematics and send time come from the attack model
+            attackMsg->setSrcId(forged.srcId);
+            attackMsg->setSenderPosX(forged.posX);
+            attackMsg->setSenderPosY(forged.posY);
+            attackMsg->setSenderSpeedX(forged.speedX);
+            attackMsg->setSenderSpeedY(forged.speedY);
+            attackMsg->setTimestamp(forged.timestamp);
+            sendDown(attackMsg);
             attackPacketsSent++;
             packetsSent++;
             packetsSentVector.record(packetsSent);
-            EV_INFO << "SPOOF ATTACK #" << attackCounter << " sent by "
-                    << getParentModule()->getFullName() << endl;
-
-        } else if (attackType == "replay") {
-            MyMsg* replayMsg = new MyMsg();
-            populateMyMsg(replayMsg , true);
-            // Set old position using custom fields
-            replayMsg->setSenderPosX(curPosition.x - 500);
-            replayMsg->setSenderPosY(curPosition.y - 500);
-            replayMsg->setSenderSpeedX(100);
-            replayMsg->setSenderSpeedY(0);
-            sendDown(replayMsg);
-            attackPacketsSent++;
-            packetsSent++;
-            packetsSentVector.record(packetsSent);
-            EV_INFO << "REPLAY ATTACK #" << attackCounter << " sent by "
-                    << getParentModule()->getFullName() << endl;
         }
+        EV_INFO << attackModel->getName() << " attack #" << attackCounter << " sent by "
+                << getParentModule()->getFullName() << " | " << forgedBeacons.size() << " beacons" << endl;
 
         bubble("ATTACKING");
-        scheduleAt(simTime() + par("attackInterval").doubleValue(), attackTimer);
+        scheduleAt(simTime() + attackModel->nextTick(simTime().dbl()), attackTimer);
 
     } else if (msg == evasiveTimer) {
         endEvasiveAction();
 
+    } else if (msg == dccTimer) {
+        runDcc();
+
+    } else if (msg == senderWheelTimer) {
+        runSenderWheel();
+
     } else {
         MyMsg* normalMsg = new MyMsg();
        populateMyMsg(normalMsg , false);
        sendDown(normalMsg);
        normalPacketsSent++;
+       if (attackModel) {
+           attackModel->noteOwnBeacon(simTime().dbl());
+       }
        packetsSent++;
        packetsSentVector.record(packetsSent);
 
-       // Reschedule the beacon timer (what parent would do)
-       scheduleAt(simTime() + 1.0, msg); // Reschedule for 1 second later
+       // Reschedule the beacon timer (what parent would do), at the DCC rate if enabled
+       simtime_t nextBeacon = simTime() + nextBeaconInterval();
+       if (beaconJitter > SIMTIME_ZERO) {
+           nextBeacon += uniform(SIMTIME_ZERO, beaconJitter);
+       }
+       scheduleAt(nextBeacon, msg);
     }
 }
 
 void MyVeinsApp::handlePositionUpdate(cObject* obj) {
+    V2V_PROFILE_SCOPE("app.position");
     DemoBaseApplLayer::handlePositionUpdate(obj);
 
     // Record throughput periodically
@@ -639,11 +1090,53 @@ void MyVeinsApp::handlePositionUpdate(cObject* obj) {
     }
 
     if (underAttack && mobility->getSpeed() > 5) {
-        traciVehicle->setSpeed(5);
+        traciCommands.setSpeed(5);
+        if (!batchTraciCommands) {
+            flushTraciCommands();
+        }
     }
 }
 
+AppCounters MyVeinsApp::captureCounters() const {
+    AppCounters counters;
+    counters.attackCounter = attackCounter;
+    counters.normalPacketsSent = normalPacketsSent;
+    counters.attackPacketsSent = attackPacketsSent;
+    counters.packetsReceived = packetsReceived;
+    counters.attacksDetected = attacksDetected;
+    counters.packetsSent = packetsSent;
+    counters.totalDetections = detectionStats.totalDetections;
+    counters.highRateDetections = detectionStats.highRateDetections;
+    counters.packetsBlocked = detectionStats.packetsBlocked;
+    counters.falsePositives = detectionStats.falsePositives;
+    return counters;
+}
+
+void MyVeinsApp::restoreCounters(const AppCounters& counters) {
+    attackCounter = counters.attackCounter;
+    normalPacketsSent = counters.normalPacketsSent;
+    attackPacketsSent = counters.attackPacketsSent;
+    packetsReceived = counters.packetsReceived;
+    attacksDetected = counters.attacksDetected;
+    packetsSent = counters.packetsSent;
+    detectionStats.totalDetections = counters.totalDetections;
+    detectionStats.highRateDetections = counters.highRateDetections;
+    detectionStats.packetsBlocked = counters.packetsBlocked;
+    detectionStats.falsePositives = counters.falsePositives;
+}
+
+void MyVeinsApp::flushTraciCommands() {
+    Enter_Method_Silent();
+    V2V_PROFILE_SCOPE("traci.commands");
+    traciCommands.flush(traciVehicle);
+}
+
 void MyVeinsApp::finish() {
+    // Write the last, partial aggregation intervals
+    packetsSentVector.flush();
+    endToEndDelayVector.flush();
+    jitterVector.flush();
+
     // ========== PERSONAL PDR CALCULATION ==========
     int myPacketsSent = 0;
     int myPacketsDelivered = 0;
@@ -689,15 +1182,31 @@ void MyVeinsApp::finish() {
 
     if (!malicious && detectionEnabled) {
 
-        // Calculate detection accuracy if we have ground truth
-        if (totalAttackers > 0) {
-            double detectionRate = (double)detectionStats.totalDetections / totalAttackers * 100;
-            EV_INFO << "Estimated Detection Rate: " << detectionRate << "%" << endl;
+        // Detection accuracy against ground truth
+        const DetectionCounts& counts = detectionMetrics.getCounts();
+        EV_INFO << "Detection Recall: " << counts.recall() * 100 << "%"
+                << " | Precision: " << counts.precision() * 100 << "%"
+                << " | False Positives: " << detectionStats.falsePositives << endl;
+
+        recordScalar("detectionPrecision", counts.precision());
+        recordScalar("detectionRecall", counts.recall());
+        recordScalar("detectionFalsePositiveRate", counts.falsePositiveRate());
+        recordScalar("truePositives", counts.truePositives);
+        recordScalar("falsePositives", counts.falsePositives);
+        if (counts.attackerPairsDetected > 0) {
+            recordScalar("meanTimeToDetect", counts.meanTimeToDetect());
         }
 
+        detectionMetrics.closeBlacklistPeriods(simTime().dbl(), [this](double dwell, bool) {
+            blacklistDwellHistogram.collect(dwell);
+        });
+        recordStatistic(&timeToDetectHistogram, "s");
+        recordStatistic(&blacklistDwellHistogram, "s");
+        networkDetectionCounts.add(counts);
+
         // Log blacklisted nodes
         int blacklistedCount = 0;
-        for (const auto& counter : messageCounters) {
+        for (const auto& counter : detector.getCounters()) {
             if (counter.second.isBlacklisted) {
                 blacklistedCount++;
                 EV_DEBUG << "Blacklisted: Node " << counter.first
@@ -705,8 +1214,51 @@ void MyVeinsApp::finish() {
             }
         }
         EV_INFO << "Total Blacklisted Nodes: " << blacklistedCount << endl;
+
+        if (sybilDetection) {
+            EV_INFO << "Sybil identities: " << sybilDetector.countSybil()
+                    << " of " << sybilDetector.getSenderCount() << " tracked senders" << endl;
+            recordScalar("sybilDetections", sybilDetections);
+            recordScalar("sybilIdentities", sybilDetector.countSybil());
+        }
+    }
+
+    if (cooperativeBlacklist) {
+        recordScalar("misbehaviorReportsSent", reportsSent);
+        recordScalar("revocationUpdatesApplied", revocationUpdatesApplied);
+        recordScalar("revocationUpdatesRejected", revocationUpdatesRejected);
+        recordScalar("packetsDroppedRevoked", packetsDroppedRevoked);
     }
 
+    if (trustRsuVerdicts) {
+        recordScalar("detectionOffloaded", detectionOffloaded);
+        recordScalar("packetsDroppedByRsu", packetsDroppedByRsu);
+    }
+
+    // Tail latency; defenders' sketches also go into the network-wide ones
+    recordQuantiles(this, "endToEndDelay", delaySketch);
+    recordQuantiles(this, "jitter", jitterSketch);
+    recordQuantiles(this, "interArrivalTime", interArrivalSketch);
+    if (!malicious) {
+        networkDelaySketch.merge(delaySketch);
+        networkJitterSketch.merge(jitterSketch);
+        networkInterArrivalSketch.merge(interArrivalSketch);
+    }
+
+    recordScalar("traciCommandsRequested", traciCommands.getRequested());
+    recordScalar("traciCommandsSent", traciCommands.getSent());
+    recordScalar("traciRoundTripsSaved", traciCommands.getSaved());
+
+    if (senderWheelTimer) {
+        recordScalar("blacklistsExpired", blacklistsExpired);
+        recordScalar("suspicionDecays", suspicionDecays);
+        recordScalar("sendersEvicted", sendersEvicted);
+    }
+
+    // Per-module memory for the scaling runs (tools/scale_bench)
+    recordScalar("detectorMemory", detector.memoryFootprint(), "B");
+    recordScalar("detectorSenders", detector.getCounters().size());
+
     // ========== GLOBAL STATISTICS (only node[0]) ==========
     if (getParentModule()->getIndex() == 0) {
         // Calculate global PDR
@@ -737,7 +1289,7 @@ void MyVeinsApp::finish() {
         EV_INFO << "Non-Attacking Nodes: " << totalDefenders << endl;
         EV_INFO << "Attacking Nodes: " << totalAttackers << endl;
 
-        EV_INFO << "Total Unique Senders: " << messageCounters.size() << endl;
+        EV_INFO << "Total Unique Senders: " << detector.getCounters().size() << endl;
     }
 
     // Node-specific summary
@@ -749,12 +1301,7 @@ void MyVeinsApp::finish() {
         EV_INFO << "Normal Packets Sent: " << normalPacketsSent << endl;
     } else {
         if(detectionEnabled){
-            int blacklistedAttackers = 0;
-            for (const auto& counter : messageCounters) {
-                if (counter.second.isBlacklisted) {
-                    blacklistedAttackers++;
-                }
-            }
+            int blacklistedAttackers = detector.countBlacklisted();
 
             EV_INFO << "=== DEFENDER SUMMARY ===" << endl;
             EV_INFO << "Successful Attack Detections: " << attacksDetected << endl;
@@ -764,14 +1311,77 @@ void MyVeinsApp::finish() {
 
     EV_INFO << "=== END OF STATISTICS ===" << endl << endl;
 
+    std::string saveStateFile = par("saveStateFile").stdstringValue();
+    if (!saveStateFile.empty() && mobility) {
+        savedState.put(mobility->getExternalId(), captureCounters());
+    }
 
     DemoBaseApplLayer::finish();
 }
 
+void MyVeinsApp::recordQuantiles(cComponent* target, const char* name, const QuantileSketch& sketch) {
+    if (sketch.getCount() == 0) {
+        return;
+    }
+    std::string prefix = name;
+    target->recordScalar((prefix + "P50").c_str(), sketch.quantile(0.5), "s");
+    target->recordScalar((prefix + "P95").c_str(), sketch.quantile(0.95), "s");
+    target->recordScalar((prefix + "P99").c_str(), sketch.quantile(0.99), "s");
+    target->recordScalar((prefix + "Samples").c_str(), sketch.getCount());
+}
+
+void MyVeinsApp::finishRun(cComponent* target) {
+    EV_STATICCONTEXT;
+    if (!runHasApps) {
+        return;                                    // A later run of the process without MyVeinsApp
+    }
+    runHasApps = false;
+
+    // Network-wide detection accuracy and tail latency, on the network module
+    recordNetworkDetectionMetrics(target);
+
+    EV_INFO << "Network end-to-end delay of legitimate packets: p50 " << networkDelaySketch.quantile(0.5) * 1000
+            << "ms, p95 " << networkDelaySketch.quantile(0.95) * 1000
+            << "ms, p99 " << networkDelaySketch.quantile(0.99) * 1000 << "ms" << endl;
+    recordQuantiles(target, "networkEndToEndDelay", networkDelaySketch);
+    recordQuantiles(target, "networkJitter", networkJitterSketch);
+    recordQuantiles(target, "networkInterArrivalTime", networkInterArrivalSketch);
+    networkDelaySketch.clear();
+    networkJitterSketch.clear();
+    networkInterArrivalSketch.clear();
+
+#ifdef V2V_PROFILE_STAGES
+    cModule* systemModule = getSimulation()->getSystemModule();
+    systemModule->unsubscribe(TraCIScenarioManager::traciTimestepBeginSignal, &traciStepProfiler);
+    systemModule->unsubscribe(TraCIScenarioManager::traciTimestepEndSignal, &traciStepProfiler);
+    if (!runProfileFile.empty()) {
+        StageProfiler& profiler = StageProfiler::instance();
+        if (!profiler.writeFolded(runProfileFile + ".folded") || !profiler.writeSummary(runProfileFile + ".csv")) {
+            EV_WARN << "Cannot write stage profile " << runProfileFile << endl;
+        }
+        profiler.clear();
+    }
+#endif
+
+    // Hand the counters of all vehicles to warm-started runs
+    if (!runSaveStateFile.empty()) {
+        if (!savedState.save(runSaveStateFile)) {
+            EV_WARN << "Cannot write app state file " << runSaveStateFile << endl;
+        }
+        savedState.clear();
+    }
+
+    if (traceWriter.isOpen()) {
+        EV_INFO << "Detection trace records written: " << traceWriter.getRecordsWritten() << endl;
+        traceWriter.close();
+    }
+}
+
 MyVeinsApp::MyVeinsApp() {
     // Constructor
 }
 
 MyVeinsApp::~MyVeinsApp() {
-    // Destructor
+    cancelAndDelete(dccTimer);
+    cancelAndDelete(senderWheelTimer);
 }
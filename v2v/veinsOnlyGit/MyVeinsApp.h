@@ -2,11 +2,27 @@
 #define MYVEINSAPP_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <deque>
 #include <string>
+#include <unordered_map>
 #include <omnetpp.h>
 #include "veins/modules/application/ieee80211p/DemoBaseApplLayer.h"
+#include "veins/modules/application/traci/SecurityDetector.h"
+#include "veins/modules/application/traci/AttackModel.h"
+#include "veins/modules/application/traci/SybilDetector.h"
+#include "veins/modules/application/traci/TimingWheel.h"
+#include "veins/modules/application/traci/DetectionTrace.h"
+#include "veins/modules/application/traci/DetectionMetrics.h"
+#include "veins/modules/application/traci/DccController.h"
+#include "veins/modules/application/traci/RevocationList.h"
+#include "veins/modules/application/traci/TraCICommandQueue.h"
+#include "veins/modules/application/traci/AppStateStore.h"
+#include "veins/modules/application/traci/DownsampledOutVector.h"
+#include "veins/modules/application/traci/QuantileSketch.h"
+#include "veins/modules/application/traci/StageProfiler.h"
+#include "veins/modules/utility/SignalManager.h"
 
 using namespace omnetpp;
 
@@ -14,19 +30,10 @@ namespace veins {
 
 // Forward declaration
 class MyMsg;
-
-// Enhanced message counter with sliding window support
-struct MessageCounter {
-    int count = 0;                          // Current message count in window
-    simtime_t startTime = -1;               // Start time of current window
-    simtime_t suspicionStartTime = -1;      // When suspicion started
-    simtime_t blacklistTime = -1;           // When blacklisted
-    bool isBlacklisted = false;             // Blacklist status
-    int suspicionLevel = 0;                 // Suspicion level (0-10)
-    std::deque<simtime_t> messageTimestamps; // Sliding window of timestamps
-
-    MessageCounter() = default;
-};
+class Mac1609_4;
+class AdmissionFilter;
+class RevocationUpdate;
+class EdgeVerdict;
 
 // Delivery information for global tracking
 struct DeliveryInfo {
@@ -37,6 +44,12 @@ struct DeliveryInfo {
     DeliveryInfo() = default;
 };
 
+// Network-wide detection timeline of one attacker
+struct AttackerTimeline {
+    simtime_t firstHeard = -1;              // First reception by any defender
+    simtime_t firstDetected = -1;           // First detection by any defender
+};
+
 // Detection statistics
 struct DetectionStatistics {
     int totalDetections = 0;                // Total malicious behavior detections
@@ -55,26 +68,9 @@ private:
     bool malicious = false;                         // Whether this node is malicious
     bool detectionEnabled = true;                  // Master detection switch
     bool underAttack = false;                       // Whether node is under attack
-    bool entropyBasedDetectionEnabled = true;      // Entropy-based detection
-    bool messageValidationEnabled = true;          // Message content validation
-
-    // ==================== DETECTION THRESHOLDS ====================
-    double floodThreshold = 50.0;                  // Basic flood detection threshold
-    double severeFloodThreshold = 100.0;           // Severe flood threshold
-    double burstThreshold = 200.0;                 // Burst attack threshold
-    double anomalyThreshold = 2.0;                 // Anomaly detection threshold
-
-    // ==================== TIMING PARAMETERS ====================
-    simtime_t detectionWindow = 3.0;               // Primary detection window (3 seconds)
-    simtime_t blacklistTimeout = 30.0;             // Blacklist duration (30 seconds)
-    simtime_t persistentFloodDuration = 6.0;       // Persistent flood duration (6 seconds)
-    simtime_t maxBurstDuration = 1.0;              // Maximum burst duration (1 second)
-    simtime_t maxMessageAge = 5.0;                 // Maximum acceptable message age (5 seconds)
-
-    // ==================== BEHAVIORAL PARAMETERS ====================
-    int minBurstSize = 50;                         // Minimum messages for burst
-    int maxSuspicionLevel = 3;                     // Maximum suspicion level
-    double maxReasonableSpeed = 50.0;              // Maximum believable speed (50 m/s = 180 km/h)
+
+    // ==================== DETECTION PARAMETERS ====================
+    DetectorParams detectorParams;                 // Thresholds, timing and behavioral parameters
 
     // ==================== ATTACK COUNTERS ====================
     int attackCounter = 0;                         // Attack attempts counter
@@ -92,10 +88,19 @@ private:
     simtime_t lastArrivalTime = -1.0;              // Last packet arrival time
     simtime_t lastInterArrivalTime = -1.0;         // Last inter-arrival time
     simtime_t lastThroughputTime = 0.0;            // Last throughput calculation
+    QuantileSketch delaySketch;                    // End-to-end delay of legitimate senders' packets
+    QuantileSketch jitterSketch;                   // |Jitter| between legitimate senders' packets
+    QuantileSketch interArrivalSketch;             // Inter-arrival time of legitimate senders' packets
+    simtime_t lastLegitimateArrival = -1.0;        // Arrival state of the sketches, attack traffic left out
+    simtime_t lastLegitimateInterArrival = -1.0;
 
     // ==================== DETECTION COMPONENTS ====================
-    std::map<int, MessageCounter> messageCounters; // Per-sender counters
+    SecurityDetector detector;                     // Per-sender counters and detection algorithms
     DetectionStatistics detectionStats;            // Detection statistics
+    DetectionMetrics detectionMetrics;             // Ground-truth-aware accuracy
+    bool sybilDetection = false;                   // Identity correlation on top of the detector
+    SybilDetector sybilDetector;
+    long sybilDetections = 0;                      // Receptions flagged as Sybil identities
 
     // ==================== MESSAGE TRACKING ====================
     std::map<int, int> receivedMessages;           // Messages received per sender
@@ -103,23 +108,113 @@ private:
     simtime_t lastWindowStart = 0.0;               // Last window start time
     simtime_t attackDetectedAt = -1.0;             // When attack was detected
 
+    // ==================== ATTACK BEHAVIOUR ====================
+    std::unique_ptr<AttackModel> attackModel;      // Registered model named by attackType, malicious nodes only
+    std::vector<ForgedBeacon> forgedBeacons;       // Reused for every attack tick
+
     // ==================== TIMERS ====================
     cMessage* attackTimer = nullptr;               // Attack scheduling timer
     cMessage* evasiveTimer = nullptr;              // Evasive action timer
+    cMessage* dccTimer = nullptr;                  // CBR measurement timer
+    cMessage* senderWheelTimer = nullptr;          // Tick of the sender timing wheel
+
+    // ==================== SENDER TABLE MAINTENANCE ====================
+    enum SenderTimerKind {
+        BlacklistExpiry,
+        SuspicionDecay,
+        IdleEviction
+    };
+    struct SenderTimers {
+        TimingWheel::TimerId blacklistExpiry = TimingWheel::InvalidTimer;
+        TimingWheel::TimerId suspicionDecay = TimingWheel::InvalidTimer;
+        TimingWheel::TimerId idleEviction = TimingWheel::InvalidTimer;
+    };
+    TimingWheel senderWheel;                       // Per-sender timers, one self message per tick
+    std::unordered_map<int, SenderTimers> senderTimers;
+    simtime_t senderIdleTimeout;                   // Evict senders silent this long, 0 keeps them
+    simtime_t suspicionDecayInterval;              // One suspicion level less per interval, 0 never
+    long blacklistsExpired = 0;
+    long suspicionDecays = 0;
+    long sendersEvicted = 0;
+
+    // ==================== CONGESTION CONTROL ====================
+    DccController dcc;                             // Beacon rate/power adaptation
+    Mac1609_4* dccMac = nullptr;                   // MAC reporting channel busy/idle
+    simtime_t dccMeasurementInterval = 0.1;        // CBR measurement period
+    int dccState = -1;                             // Last DCC state logged
+    double currentTxPower = -1;                    // Last tx power applied (mW)
+    double currentBeaconInterval = -1;             // Last beacon interval recorded (s)
+    simtime_t beaconJitter = 0;                    // Max random extra delay per beacon
+
+    // ==================== TRACI COMMANDS ====================
+    bool batchTraciCommands = true;                // Hold commands until the next TraCI step
+    TraCICommandQueue traciCommands;               // Coalesced commands for this vehicle
+    SignalManager signalManager;                   // Step begin subscription
 
     // ==================== STATISTICS ====================
-    cOutVector packetsSentVector;                  // Packets sent over time
+    DownsampledOutVector packetsSentVector;        // Packets sent over time
     cOutVector packetsReceivedVector;              // Packets received over time
-    cOutVector endToEndDelayVector;                // End-to-end delay
-    cOutVector jitterVector;                       // Jitter measurements
+    DownsampledOutVector endToEndDelayVector;      // End-to-end delay
+    DownsampledOutVector jitterVector;             // Jitter measurements
     cOutVector throughputVector;                   // Throughput over time
     cOutVector detectionRateVector;                // Detection rate over time
     cOutVector falsePositiveVector;                // False positives over time
+    cOutVector cbrVector;                          // Measured channel busy ratio
+    cOutVector beaconIntervalVector;               // DCC beacon interval
+    cOutVector txPowerVector;                      // DCC tx power
+    cHistogram timeToDetectHistogram;              // Per-attacker time to first detection
+    cHistogram blacklistDwellHistogram;            // Blacklist period lengths
 
     // Static members for global tracking
     static std::map<long, DeliveryInfo> globalPacketMap;    // Global packet delivery info
     static long nextPacketId;                               // Next packet ID
 
+    // Ground truth and network-wide detection accuracy
+    static std::set<int> maliciousNodes;                    // Ids of malicious nodes
+    static int nextForgedId;                                // Attackers take consecutive blocks of forged sender IDs
+    static std::map<int, AttackerTimeline> attackerTimelines; // Per-attacker detection timeline
+    static DetectionCounts networkDetectionCounts;          // Sum over finished defenders
+    static QuantileSketch networkDelaySketch;               // Merged over finished nodes
+    static QuantileSketch networkJitterSketch;
+    static QuantileSketch networkInterArrivalSketch;
+    static bool runListenerAdded;                           // finishRun hooked into the simulation lifecycle
+    static bool runHasApps;                                 // Any app initialized in the current run
+    static std::string runProfileFile;                      // Outputs written once per run by finishRun
+    static std::string runSaveStateFile;
+
+    // Detector input trace, shared by all nodes of a run
+    static DetectionTraceWriter traceWriter;                // Open until the end of the run
+    bool tracing = false;                                   // Whether this node records its receptions
+
+    // Warm start: counters handed from a warm-up run to the runs continuing from it
+    static AppStateStore savedState;                        // Collected at finish, written at the end of the run
+    static AppStateStore loadedState;                       // Read once per run
+    static std::string loadedStateFile;
+
+    static const simsignal_t channelBusySignal;             // Mac1609_4 busy/idle notification
+
+    AdmissionFilter* admissionFilter = nullptr;             // Receive path filter (SecureCar hosts only)
+
+    // ==================== COOPERATIVE BLACKLIST ====================
+    bool cooperativeBlacklist = false;                      // Report to / follow the RSU revocation lists
+    uint64_t revocationKey = 0;                             // Key for verifying RSU updates
+    simtime_t reportInterval;                               // Minimum time between reports on a suspect
+    std::map<int, RevocationList> rsuRevocations;           // Revocation list per issuing RSU
+    SenderBitmap revokedSenders;                            // Union of all RSU lists
+    std::map<int, simtime_t> lastReported;                  // Suspect -> last report sent
+    long reportsSent = 0;
+    long revocationUpdatesApplied = 0;
+    long revocationUpdatesRejected = 0;                     // Bad digest or missed delta
+    long packetsDroppedRevoked = 0;
+
+    // ==================== RSU EDGE DETECTION ====================
+    bool trustRsuVerdicts = false;                          // Skip local detection in RSU coverage
+    std::map<int, SenderBitmap> rsuVerdicts;                // Flagged senders per RSU
+    std::map<int, simtime_t> rsuVerdictExpiry;              // RSU -> verdicts valid until
+    SenderBitmap rsuFlaggedSenders;                         // Union over RSUs in coverage
+    long detectionOffloaded = 0;                            // Receptions not inspected locally
+    long packetsDroppedByRsu = 0;
+
 protected:
     // ==================== CORE APPLICATION METHODS ====================
     virtual void initialize(int stage) override;
@@ -129,21 +224,48 @@ protected:
     virtual void onWSM(BaseFrame1609_4* wsm) override;
     virtual void handlePositionUpdate(cObject* obj) override;
 
+    using DemoBaseApplLayer::receiveSignal;
+    virtual void receiveSignal(cComponent* source, simsignal_t signalID, bool b, cObject* details) override;
+
     // ==================== MESSAGE MANAGEMENT ====================
+    void processLowerMsg(cMessage* msg);
     void populateMyMsg(MyMsg* msg, bool attackPacket = false);
     void changeNodeColor(const char* color);
+    void initializeAttack();
 
     // ==================== ENHANCED DETECTION METHODS ====================
-
-    // Primary detection methods
-    bool isFloodAttacker(int senderId);
-    void updateMessageCounter(int senderId);
-    bool detectMaliciousBehavior(MyMsg* msg);
-
-    // Advanced detection algorithms
-    bool detectBurstAttack(const MessageCounter& counter);
-    bool detectAnomalousTraffic(int senderId, double currentRate);
-    bool validateMessageContent(MyMsg* msg);
+    ReceptionEvent makeReceptionEvent(MyMsg* msg) const;
+    double receivedPower(cMessage* msg) const;
+    void logDetection(int senderId, const DetectionResult& result);
+    void recordDetectionMetrics(int senderId, const DetectionResult& result, simtime_t now);
+    static void recordNetworkDetectionMetrics(cComponent* target);
+    static void recordQuantiles(cComponent* target, const char* name, const QuantileSketch& sketch);
+
+    // ==================== COOPERATIVE BLACKLIST ====================
+    void reportMisbehavior(int suspectId, const DetectionResult& result);
+    void onRevocationUpdate(RevocationUpdate* update);
+
+    // ==================== RSU EDGE DETECTION ====================
+    void onEdgeVerdict(EdgeVerdict* verdict);
+    bool inRsuCoverage();
+
+    // ==================== SENDER TABLE MAINTENANCE ====================
+    void trackSender(int senderId);
+    void onSenderTimer(int senderId, int kind);
+    void evictSender(int senderId);
+    void runSenderWheel();
+
+    // ==================== CONGESTION CONTROL ====================
+    void initializeDcc();
+    void runDcc();
+    simtime_t nextBeaconInterval() const;
+
+    // ==================== TRACI COMMANDS ====================
+    void flushTraciCommands();
+
+    // ==================== WARM START ====================
+    AppCounters captureCounters() const;
+    void restoreCounters(const AppCounters& counters);
 
     // Attack response methods
     void takeEvasiveAction();
@@ -154,6 +276,9 @@ public:
     MyVeinsApp();
     virtual ~MyVeinsApp();
 
+    // Network-wide output of a run, after every module has finished
+    static void finishRun(cComponent* target);
+
     // Simulation parameters (to be set from NED file)
     int totalDefenders = 16;                     // Total non-attacking nodes
     int totalAttackers = 8;                      // Total attacking nodes
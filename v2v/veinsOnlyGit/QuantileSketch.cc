@@ -0,0 +1,161 @@
+#include "veins/modules/application/traci/QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace veins;
+
+void QuantileSketch::Store::add(int key, uint64_t n, size_t maxBuckets) {
+    if (counts.empty()) {
+        offset = key;
+        counts.assign(1, 0);
+    }
+
+    int last = offset + int(counts.size()) - 1;
+    if (key < offset) {
+        // Grow downwards as far as the bound allows, lower keys share the first bucket
+        int newOffset = std::max(key, last - int(maxBuckets) + 1);
+        counts.insert(counts.begin(), offset - newOffset, 0);
+        offset = newOffset;
+        key = std::max(key, offset);
+    } else if (key > last) {
+        // Grow upwards, collapsing the lowest buckets into one if needed
+        int newOffset = std::max(offset, key - int(maxBuckets) + 1);
+        if (newOffset > offset) {
+            size_t folded = std::min(counts.size(), size_t(newOffset - offset));
+            uint64_t collapsed = 0;
+            for (size_t i = 0; i < folded; i++) {
+                collapsed += counts[i];
+            }
+            counts.erase(counts.begin(), counts.begin() + folded);
+            if (counts.empty()) {
+                counts.assign(1, 0);
+            }
+            counts[0] += collapsed;
+            offset = newOffset;
+        }
+        counts.resize(key - offset + 1, 0);
+    }
+    counts[key - offset] += n;
+}
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, size_t maxBuckets)
+    : relativeAccuracy(relativeAccuracy), maxBuckets(std::max<size_t>(1, maxBuckets)) {
+    if (relativeAccuracy <= 0 || relativeAccuracy >= 1) {
+        throw std::invalid_argument("relative accuracy must lie in (0, 1)");
+    }
+    gamma = (1 + relativeAccuracy) / (1 - relativeAccuracy);
+    logGamma = std::log(gamma);
+    minIndexable = std::numeric_limits<double>::min() * gamma;
+}
+
+int QuantileSketch::key(double magnitude) const {
+    return int(std::ceil(std::log(magnitude) / logGamma));
+}
+
+double QuantileSketch::value(int key) const {
+    // Midpoint of (gamma^(key-1), gamma^key] in relative terms
+    return 2 * std::pow(gamma, key) / (gamma + 1);
+}
+
+void QuantileSketch::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    if (value > minIndexable) {
+        positive.add(key(value), 1, maxBuckets);
+    } else if (value < -minIndexable) {
+        negative.add(key(-value), 1, maxBuckets);
+    } else {
+        zeroCount++;
+    }
+
+    if (count == 0) {
+        min = max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    sum += value;
+    count++;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.relativeAccuracy != relativeAccuracy) {
+        throw std::invalid_argument("cannot merge quantile sketches of different accuracy");
+    }
+    if (other.count == 0) {
+        return;
+    }
+    for (size_t i = 0; i < other.positive.counts.size(); i++) {
+        if (other.positive.counts[i]) {
+            positive.add(other.positive.offset + int(i), other.positive.counts[i], maxBuckets);
+        }
+    }
+    for (size_t i = 0; i < other.negative.counts.size(); i++) {
+        if (other.negative.counts[i]) {
+            negative.add(other.negative.offset + int(i), other.negative.counts[i], maxBuckets);
+        }
+    }
+    zeroCount += other.zeroCount;
+
+    if (count == 0) {
+        min = other.min;
+        max = other.max;
+    } else {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+    sum += other.sum;
+    count += other.count;
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = uint64_t(q * (count - 1));
+    if (rank == 0) {
+        return min;
+    }
+    if (rank == count - 1) {
+        return max;
+    }
+
+    // Ascending order: large negative magnitudes first, then zero, then positives
+    double result = max;
+    uint64_t seen = 0;
+    bool found = false;
+    for (size_t i = negative.counts.size(); i-- > 0 && !found;) {
+        seen += negative.counts[i];
+        if (seen > rank) {
+            result = -value(negative.offset + int(i));
+            found = true;
+        }
+    }
+    if (!found) {
+        seen += zeroCount;
+        if (seen > rank) {
+            result = 0;
+            found = true;
+        }
+    }
+    for (size_t i = 0; i < positive.counts.size() && !found; i++) {
+        seen += positive.counts[i];
+        if (seen > rank) {
+            result = value(positive.offset + int(i));
+            found = true;
+        }
+    }
+    return std::min(max, std::max(min, result));
+}
+
+void QuantileSketch::clear() {
+    positive = Store();
+    negative = Store();
+    zeroCount = 0;
+    count = 0;
+    min = max = sum = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mergeable streaming quantile sketch (DDSketch, Masson et al., VLDB 2019).
+// Values are counted in logarithmically sized buckets, so every quantile is
+// returned within the configured relative accuracy. The number of buckets per
+// sign is bounded; beyond it the buckets closest to zero are collapsed, which
+// only affects the accuracy of the lowest quantiles. Inserts are O(1)
+// amortized, merging two sketches with the same accuracy is exact.
+
+namespace veins {
+
+class QuantileSketch {
+public:
+    static constexpr double defaultRelativeAccuracy = 0.01;
+    static const size_t defaultMaxBuckets = 2048;
+
+    explicit QuantileSketch(double relativeAccuracy = defaultRelativeAccuracy, size_t maxBuckets = defaultMaxBuckets);
+
+    void add(double value);
+
+    // Throws std::invalid_argument if the accuracies differ
+    void merge(const QuantileSketch& other);
+
+    // q in [0, 1]; 0 for an empty sketch
+    double quantile(double q) const;
+
+    uint64_t getCount() const { return count; }
+    double getMin() const { return min; }
+    double getMax() const { return max; }
+    double getMean() const { return count ? sum / count : 0; }
+    double getRelativeAccuracy() const { return relativeAccuracy; }
+    size_t getBucketCount() const { return positive.counts.size() + negative.counts.size(); }
+
+    void clear();
+
+private:
+    // Contiguous bucket counts starting at key offset
+    struct Store {
+        std::vector<uint64_t> counts;
+        int offset = 0;
+
+        void add(int key, uint64_t n, size_t maxBuckets);
+    };
+
+    int key(double magnitude) const;
+    double value(int key) const;
+
+    double relativeAccuracy;
+    double gamma;
+    double logGamma;
+    double minIndexable;                           // Smaller magnitudes count as zero
+    size_t maxBuckets;
+
+    Store positive;
+    Store negative;                                // Keyed by magnitude
+    uint64_t zeroCount = 0;
+    uint64_t count = 0;
+    double min = 0;
+    double max = 0;
+    double sum = 0;
+};
+
+} // namespace veins
+
+#endif // QUANTILESKETCH_H
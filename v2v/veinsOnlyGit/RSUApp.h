@@ -1,12 +1,27 @@
 #pragma once
 
+#include <map>
 #include "veins/modules/application/ieee80211p/DemoBaseApplLayer.h"
+#include "veins/modules/application/traci/RevocationList.h"
+#include "veins/modules/application/traci/RelayBatch.h"
+#include "veins/modules/application/traci/EdgeDetector.h"
 
 namespace veins {
 
+class MisbehaviorReport;
+class ReputationMigration;
+
 class RSUApp : public DemoBaseApplLayer {
+public:
+    ~RSUApp() override;
+
+    const Coord& getPosition() const { return curPosition; }
+
 protected:
     void initialize(int stage) override;
+    void finish() override;
+    void handleMessage(cMessage* msg) override;
+    void handleSelfMsg(cMessage* msg) override;
     void onWSM(BaseFrame1609_4* wsm) override;
     void onBSM(DemoSafetyMessage* bsm) override;
 
@@ -15,7 +30,96 @@ private:
     bool relayToInternet = false;
     int messagesRelayed = 0;
 
-    void relayMessageToInternet();
+    // Relay to the backend over the wired backhaul
+    cModule* backend = nullptr;
+    double backhaulDatarate = 0;                   // bps
+    simtime_t backhaulDelay;                       // Propagation delay of the wired link
+    simtime_t backhaulBusyUntil;                   // End of the last queued transmission
+    simtime_t backhaulBusyTime;                    // Total transmission time, for utilization
+    int maxBatchRecords = 64;                      // Flush when this many messages are pending
+    int maxBatchBytes = 8000;                      // ... or this many bytes of relayed frames
+    simtime_t maxBatchDelay;                       // ... or the oldest one waited this long
+    std::vector<RelayRecord> pendingRecords;
+    std::vector<simtime_t> pendingArrivals;        // Reception time per pending record
+    int pendingRawBytes = 0;
+    cMessage* batchTimer = nullptr;
+
+    long batchesSent = 0;
+    long rawBytesRelayed = 0;
+    long backhaulBytesSent = 0;
+    cHistogram batchRecordsHistogram;              // Messages per batch
+    cHistogram compressionRatioHistogram;          // Relayed frame bytes / batch payload bytes
+    cHistogram relayQueueingDelayHistogram;        // Reception -> start of transmission upstream
+
+    // Cooperative blacklist
+    bool cooperativeBlacklist = false;
+    int voteThreshold = 2;                         // Distinct reporters needed to revoke
+    simtime_t voteWindow;                          // Reports older than this are forgotten
+    simtime_t revocationTimeout;                   // Revocations expire after this
+    simtime_t revocationInterval;                  // Update broadcast period
+    simtime_t fullListInterval;                    // Full list broadcast period
+    uint64_t revocationKey = 0;
+    int signatureLength = 64;                      // Bytes on air for the signature
+
+    RevocationList revocations;
+    std::map<int, std::map<int, simtime_t>> votes; // suspect -> reporter -> last report
+    std::map<int, simtime_t> revokedAt;            // suspect -> revocation time
+    simtime_t lastFullList;
+    cMessage* revocationTimer = nullptr;
+
+    long reportsReceived = 0;
+    long revocationsIssued = 0;
+    long updatesSent = 0;
+    long updateBytesSent = 0;
+
+    // Edge detection for the whole cell
+    bool edgeDetection = false;
+    simtime_t verdictInterval;                     // Verdict broadcast period
+    EdgeDetector edgeDetector;
+    cMessage* verdictTimer = nullptr;
+    long edgeObservations = 0;
+    long edgeFlags[4] = {};                        // Per EdgeReason
+    long verdictsSent = 0;
+    size_t edgeTablePeak = 0;
+    double edgeDetectionTime = 0;                  // Wall clock spent in the detector (s)
+
+    // Reputation handover to neighbouring RSUs
+    struct Neighbor {
+        RSUApp* app = nullptr;
+        std::vector<uint8_t> pending;              // Encoded snapshots not sent yet
+        int pendingCount = 0;
+    };
+    bool stateMigration = false;
+    simtime_t migrationInterval;                   // Prediction period
+    double handoverHorizon = 3;                    // Look-ahead of the position prediction (s)
+    simtime_t migrationCooldown;                   // Minimum time between handovers of one sender to one RSU
+    int maxMigrationBytes = 1000;                  // Payload bound per migration message
+    std::vector<Neighbor> neighbors;
+    bool neighborsResolved = false;
+    std::map<std::pair<int, RSUApp*>, simtime_t> lastMigrated;
+    cMessage* migrationTimer = nullptr;
+    int backhaulInGate = -1;
+
+    long migrationMessagesSent = 0;
+    long snapshotsSent = 0;
+    long migrationBytesSent = 0;
+    long snapshotsReceived = 0;
+    cHistogram migrationLatencyHistogram;          // Snapshot taken -> applied at the neighbour
+    cHistogram migrationSizeHistogram;             // Bytes per migration message
+
+    void relayMessageToInternet(const RelayRecord& record);
+    void flushRelayBatch();
+    simtime_t sendOverBackhaul(cPacket* pkt, cModule* target);
+    void observeSender(const ReceptionEvent& ev);
+    void sendEdgeVerdicts();
+    void resolveNeighbors();
+    void migrateReputation();
+    void sendMigration(Neighbor& neighbor);
+    void onReputationMigration(ReputationMigration* migration);
+    void onMisbehaviorReport(MisbehaviorReport* report);
+    void forgetStaleVotes(std::map<int, simtime_t>& reporters);
+    void updateRevocations();
+    void sendRevocationUpdate(bool full);
 };
 
 } // namespace veins
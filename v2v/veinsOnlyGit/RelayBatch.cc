@@ -0,0 +1,147 @@
+#include "veins/modules/application/traci/RelayBatch.h"
+#include "veins/modules/application/traci/Varint.h"
+#include <cmath>
+#include <cstring>
+
+using namespace veins;
+
+namespace {
+
+const double timeScale = 1e6;                      // Microseconds
+const double distanceScale = 100;                  // Centimetres
+
+const double quantizedLimit = 0x1p62;              // Deltas of quantized values stay within int64
+
+int64_t quantize(double value, double scale) {
+    return std::llround(value * scale);
+}
+
+// False for NaN, infinities and values too large to quantize
+bool representable(double value, double scale) {
+    return std::fabs(value * scale) < quantizedLimit;
+}
+
+// Deltas wrap around in uint64, so any pair of values round-trips
+void putDelta(std::vector<uint8_t>& out, int64_t value, int64_t& previous) {
+    putVarint(out, zigzag(int64_t(uint64_t(value) - uint64_t(previous))));
+    previous = value;
+}
+
+bool getDelta(const std::vector<uint8_t>& in, size_t& pos, int64_t& previous) {
+    uint64_t raw;
+    if (!getVarint(in, pos, raw)) {
+        return false;
+    }
+    previous = int64_t(uint64_t(previous) + uint64_t(unzigzag(raw)));
+    return true;
+}
+
+// A quantized delta, or the raw bits of a flagged field (which leaves the
+// running state alone)
+void putField(std::vector<uint8_t>& out, double value, double scale, int64_t& previous) {
+    if (representable(value, scale)) {
+        putDelta(out, quantize(value, scale), previous);
+        return;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putVarint(out, bits);
+}
+
+bool getField(const std::vector<uint8_t>& in, size_t& pos, bool raw, double scale, int64_t& previous, double& value) {
+    if (!raw) {
+        if (!getDelta(in, pos, previous)) {
+            return false;
+        }
+        value = previous / scale;
+        return true;
+    }
+    uint64_t bits;
+    if (!getVarint(in, pos, bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+// Flag bits of the fields carried raw
+enum RawField : uint64_t {
+    RawTimestamp = 1,
+    RawPosX = 2,
+    RawPosY = 4,
+    RawSpeedX = 8,
+    RawSpeedY = 16,
+    RawAll = 31
+};
+
+// Running state both sides keep while walking the batch
+struct DeltaState {
+    int64_t senderId = 0;
+    int64_t packetId = 0;
+    int64_t timestamp = 0;
+    int64_t posX = 0;
+    int64_t posY = 0;
+    int64_t speedX = 0;
+    int64_t speedY = 0;
+};
+
+} // namespace
+
+std::vector<uint8_t> veins::encodeRelayRecords(const std::vector<RelayRecord>& records) {
+    std::vector<uint8_t> out;
+    out.reserve(records.size() * 12);
+    putVarint(out, records.size());
+
+    DeltaState state;
+    for (const RelayRecord& r : records) {
+        uint64_t raw = 0;
+        raw |= representable(r.timestamp, timeScale) ? 0 : RawTimestamp;
+        raw |= representable(r.posX, distanceScale) ? 0 : RawPosX;
+        raw |= representable(r.posY, distanceScale) ? 0 : RawPosY;
+        raw |= representable(r.speedX, distanceScale) ? 0 : RawSpeedX;
+        raw |= representable(r.speedY, distanceScale) ? 0 : RawSpeedY;
+
+        putVarint(out, raw);
+        putDelta(out, r.senderId, state.senderId);
+        putDelta(out, r.packetId, state.packetId);
+        putField(out, r.timestamp, timeScale, state.timestamp);
+        putField(out, r.posX, distanceScale, state.posX);
+        putField(out, r.posY, distanceScale, state.posY);
+        putField(out, r.speedX, distanceScale, state.speedX);
+        putField(out, r.speedY, distanceScale, state.speedY);
+        putVarint(out, r.frameBytes);
+    }
+    return out;
+}
+
+bool veins::decodeRelayRecords(const std::vector<uint8_t>& payload, std::vector<RelayRecord>& records) {
+    size_t pos = 0;
+    uint64_t count;
+    if (!getVarint(payload, pos, count) || count > payload.size()) {
+        return false;
+    }
+
+    records.clear();
+    records.reserve(count);
+    DeltaState state;
+    for (uint64_t i = 0; i < count; i++) {
+        RelayRecord r;
+        uint64_t raw;
+        uint64_t frameBytes;
+        if (!getVarint(payload, pos, raw) || (raw & ~uint64_t(RawAll)) ||
+            !getDelta(payload, pos, state.senderId) || !getDelta(payload, pos, state.packetId) ||
+            !getField(payload, pos, raw & RawTimestamp, timeScale, state.timestamp, r.timestamp) ||
+            !getField(payload, pos, raw & RawPosX, distanceScale, state.posX, r.posX) ||
+            !getField(payload, pos, raw & RawPosY, distanceScale, state.posY, r.posY) ||
+            !getField(payload, pos, raw & RawSpeedX, distanceScale, state.speedX, r.speedX) ||
+            !getField(payload, pos, raw & RawSpeedY, distanceScale, state.speedY, r.speedY) ||
+            !getVarint(payload, pos, frameBytes)) {
+            return false;
+        }
+        r.senderId = int32_t(state.senderId);
+        r.packetId = state.packetId;
+        r.frameBytes = uint32_t(frameBytes);
+        records.push_back(r);
+    }
+    return pos == payload.size();
+}
@@ -0,0 +1,33 @@
+#ifndef RELAYBATCH_H
+#define RELAYBATCH_H
+
+#include <cstdint>
+#include <vector>
+
+// Vehicle messages an RSU forwards to the backend, and their batch encoding.
+// Records are delta encoded against the previous record in the batch with
+// zigzag varints; time is quantized to microseconds and kinematics to
+// centimetres (per second), which is what the backend needs. Claims a
+// malicious vehicle can make up (NaN, infinite or beyond the quantized range)
+// are flagged per record and carried as raw IEEE bits instead, so the backend
+// sees them exactly as sent.
+
+namespace veins {
+
+struct RelayRecord {
+    int32_t senderId = -1;
+    int64_t packetId = 0;
+    double timestamp = 0;                          // Send time claimed by the vehicle
+    double posX = 0;
+    double posY = 0;
+    double speedX = 0;
+    double speedY = 0;
+    uint32_t frameBytes = 0;                       // Size of the frame as received
+};
+
+std::vector<uint8_t> encodeRelayRecords(const std::vector<RelayRecord>& records);
+bool decodeRelayRecords(const std::vector<uint8_t>& payload, std::vector<RelayRecord>& records);
+
+} // namespace veins
+
+#endif // RELAYBATCH_H
@@ -0,0 +1,148 @@
+#include "veins/modules/application/traci/RevocationList.h"
+#include "veins/modules/application/traci/Varint.h"
+#include <algorithm>
+
+using namespace veins;
+
+namespace {
+
+void putIds(std::vector<uint8_t>& out, std::vector<int> ids) {
+    std::sort(ids.begin(), ids.end());
+    putVarint(out, ids.size());
+    int previous = 0;
+    for (int id : ids) {
+        putVarint(out, id - previous);
+        previous = id;
+    }
+}
+
+bool getIds(const std::vector<uint8_t>& in, size_t& pos, std::vector<int>& ids) {
+    uint64_t count;
+    if (!getVarint(in, pos, count) || count > in.size() - pos) {
+        return false;
+    }
+    ids.clear();
+    uint64_t id = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t gap;
+        if (!getVarint(in, pos, gap)) {
+            return false;
+        }
+        id += gap;
+        if (id > INT32_MAX) {
+            return false;
+        }
+        ids.push_back(int(id));
+    }
+    return true;
+}
+
+bool erase(std::vector<int>& ids, int id) {
+    auto it = std::find(ids.begin(), ids.end(), id);
+    if (it == ids.end()) {
+        return false;
+    }
+    ids.erase(it);
+    return true;
+}
+
+} // namespace
+
+void RevocationList::revoke(int id) {
+    if (id < 0 || revoked.test(id)) {
+        return;
+    }
+    revoked.set(id);
+    if (!erase(pendingRemoved, id)) {
+        pendingAdded.push_back(id);
+    }
+}
+
+void RevocationList::restore(int id) {
+    if (!revoked.test(id)) {
+        return;
+    }
+    revoked.reset(id);
+    if (!erase(pendingAdded, id)) {
+        pendingRemoved.push_back(id);
+    }
+}
+
+std::vector<uint8_t> RevocationList::takeDelta() {
+    std::vector<uint8_t> payload;
+    putIds(payload, pendingAdded);
+    putIds(payload, pendingRemoved);
+    pendingAdded.clear();
+    pendingRemoved.clear();
+    epoch++;
+    return payload;
+}
+
+std::vector<uint8_t> RevocationList::encodeFull() const {
+    std::vector<uint8_t> payload;
+    putIds(payload, revoked.ids());
+    putIds(payload, {});
+    return payload;
+}
+
+bool RevocationList::applyDelta(uint32_t baseEpoch, uint32_t newEpoch, const std::vector<uint8_t>& payload) {
+    if (baseEpoch != epoch || newEpoch <= epoch) {
+        return false;
+    }
+    size_t pos = 0;
+    std::vector<int> added, removed;
+    if (!getIds(payload, pos, added) || !getIds(payload, pos, removed) || pos != payload.size()) {
+        return false;
+    }
+    for (int id : added) {
+        revoked.set(id);
+    }
+    for (int id : removed) {
+        revoked.reset(id);
+    }
+    epoch = newEpoch;
+    return true;
+}
+
+bool RevocationList::applyFull(uint32_t newEpoch, const std::vector<uint8_t>& payload) {
+    size_t pos = 0;
+    std::vector<int> added, removed;
+    if (!getIds(payload, pos, added) || !getIds(payload, pos, removed) || pos != payload.size() || !removed.empty()) {
+        return false;
+    }
+    revoked.clear();
+    for (int id : added) {
+        revoked.set(id);
+    }
+    epoch = newEpoch;
+    return true;
+}
+
+void RevocationList::clear() {
+    revoked.clear();
+    epoch = 0;
+    pendingAdded.clear();
+    pendingRemoved.clear();
+}
+
+uint64_t veins::revocationDigest(uint64_t key, int issuerId, bool full, uint32_t baseEpoch, uint32_t epoch,
+                                 const std::vector<uint8_t>& payload) {
+    // FNV-1a over key, header and payload
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(key, 8);
+    mix(uint32_t(issuerId), 4);
+    mix(full, 1);
+    mix(baseEpoch, 4);
+    mix(epoch, 4);
+    for (uint8_t byte : payload) {
+        mix(byte, 1);
+    }
+    mix(key, 8);
+    return hash;
+}
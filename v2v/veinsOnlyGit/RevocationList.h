@@ -0,0 +1,53 @@
+#ifndef REVOCATIONLIST_H
+#define REVOCATIONLIST_H
+
+#include <cstdint>
+#include <vector>
+#include "veins/modules/application/traci/SenderBitmap.h"
+
+// Versioned set of revoked node IDs as distributed by the RSUs. Every change
+// set advances the epoch by one and is shipped as a delta against the previous
+// epoch; a full list resynchronises receivers that missed a delta.
+//
+// Wire format (both delta and full list): a varint count of added IDs followed
+// by the ascending IDs gap-encoded as varints, then the same for removed IDs.
+// A full list has no removals. Dense clusters of attacker IDs cost one byte
+// per ID.
+
+namespace veins {
+
+class RevocationList {
+public:
+    bool isRevoked(int id) const { return revoked.test(id); }
+    uint32_t getEpoch() const { return epoch; }
+    int count() const { return revoked.count(); }
+    const SenderBitmap& getBitmap() const { return revoked; }
+
+    // Issuer side: stage changes, then take them as the next delta
+    void revoke(int id);
+    void restore(int id);
+    bool hasPendingChanges() const { return !pendingAdded.empty() || !pendingRemoved.empty(); }
+    std::vector<uint8_t> takeDelta();              // Advances the epoch
+    std::vector<uint8_t> encodeFull() const;
+
+    // Receiver side: false if the payload is malformed or does not apply to
+    // the current epoch (the list is then left untouched)
+    bool applyDelta(uint32_t baseEpoch, uint32_t newEpoch, const std::vector<uint8_t>& payload);
+    bool applyFull(uint32_t newEpoch, const std::vector<uint8_t>& payload);
+
+    void clear();
+
+private:
+    SenderBitmap revoked;
+    uint32_t epoch = 0;                            // 0: nothing received/issued yet
+    std::vector<int> pendingAdded;
+    std::vector<int> pendingRemoved;
+};
+
+// Keyed 64 bit digest over an update, standing in for the RSU's signature
+uint64_t revocationDigest(uint64_t key, int issuerId, bool full, uint32_t baseEpoch, uint32_t epoch,
+                          const std::vector<uint8_t>& payload);
+
+} // namespace veins
+
+#endif // REVOCATIONLIST_H
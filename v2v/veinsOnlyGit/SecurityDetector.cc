@@ -0,0 +1,398 @@
+#include "veins/modules/application/traci/SecurityDetector.h"
+#include "veins/modules/application/traci/StageProfiler.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace veins;
+
+const char* veins::detectionReasonName(DetectionReason reason) {
+    switch (reason) {
+        case DetectionReason::None: return "none";
+        case DetectionReason::Blacklisted: return "Blacklisted sender";
+        case DetectionReason::SevereFlood: return "Severe flooding";
+        case DetectionReason::PersistentFlood: return "Persistent flooding";
+        case DetectionReason::BurstAttack: return "Burst attack detected";
+        case DetectionReason::SustainedFlood: return "Sustained high rate";
+        case DetectionReason::AnomalousTraffic: return "Anomalous traffic pattern";
+        case DetectionReason::InvalidContent: return "Invalid message content";
+        case DetectionReason::SybilIdentity: return "Sybil identity";
+    }
+    return "unknown";
+}
+
+const char* veins::contentCheckName(ContentCheck check) {
+    switch (check) {
+        case ContentCheck::Valid: return "valid";
+        case ContentCheck::InvalidPosition: return "invalid position coordinates";
+        case ContentCheck::UnreasonableSpeed: return "unreasonable speed";
+        case ContentCheck::FutureTimestamp: return "future timestamp";
+        case ContentCheck::StaleMessage: return "stale message";
+    }
+    return "unknown";
+}
+
+SecurityDetector::SecurityDetector(const DetectorParams& params)
+    : params(params) {
+}
+
+// ==================== RECEIVE PATH ====================
+
+DetectionResult SecurityDetector::inspect(const ReceptionEvent& ev) {
+    DetectionResult result;
+
+    // Check blacklist first
+    {
+        V2V_PROFILE_SCOPE("detection.blacklist");
+        if (isFloodAttacker(ev.senderId, ev.time, result)) {
+            result.verdict = DetectionVerdict::Blocked;
+            return result;
+        }
+    }
+
+    // Update counter and check for new attacks
+    {
+        V2V_PROFILE_SCOPE("detection.counter");
+        updateMessageCounter(ev.senderId, ev.time);
+    }
+
+    // Comprehensive malicious behavior detection
+    V2V_PROFILE_SCOPE("detection.behavior");
+    return detectMaliciousBehavior(ev);
+}
+
+// ==================== ENHANCED FLOOD ATTACK PREVENTION ====================
+
+bool SecurityDetector::isFloodAttacker(int senderId, double now) {
+    DetectionResult ignored;
+    return isFloodAttacker(senderId, now, ignored);
+}
+
+bool SecurityDetector::isFloodAttacker(int senderId, double now, DetectionResult& result) {
+    auto it = messageCounters.find(senderId);
+    if (it == messageCounters.end()) {
+        return false;
+    }
+
+    MessageCounter& counter = it->second;
+
+    // Enhanced window management with sliding window
+    if (now - counter.startTime > params.detectionWindow) {
+        // Slide the window - keep recent data for better detection
+        if (counter.messageTimestamps.size() > 0) {
+            // Remove old timestamps outside current window
+            double oldThreshold = now - params.detectionWindow;
+            while (!counter.messageTimestamps.empty() &&
+                   counter.messageTimestamps.front() < oldThreshold) {
+                counter.messageTimestamps.pop_front();
+            }
+            setCount(counter, int(counter.messageTimestamps.size()));
+            counter.startTime = counter.messageTimestamps.empty() ?
+                               now : counter.messageTimestamps.front();
+        } else {
+            setCount(counter, 0);
+            counter.startTime = now;
+        }
+        setBlacklisted(counter, false); // Give another chance after cleanup
+    }
+
+    result.rate = counter.count;
+
+    // Multi-level threshold detection
+    if (counter.count > params.severeFloodThreshold) {
+        // Severe flooding - immediate blacklist
+        setBlacklisted(counter, true);
+        counter.blacklistTime = now;
+        result.reason = DetectionReason::SevereFlood;
+        return true;
+    }
+    else if (counter.count > params.floodThreshold) {
+        // Moderate flooding - check persistence
+        if (counter.suspicionStartTime == -1) {
+            counter.suspicionStartTime = now;
+        }
+
+        double suspicionDuration = now - counter.suspicionStartTime;
+        if (suspicionDuration > params.persistentFloodDuration) {
+            setBlacklisted(counter, true);
+            counter.blacklistTime = now;
+            result.reason = DetectionReason::PersistentFlood;
+            result.duration = suspicionDuration;
+            return true;
+        }
+        return false; // Not blacklisted yet, but suspicious
+    }
+    else {
+        // Normal rate - reset suspicion
+        counter.suspicionStartTime = -1;
+        if (counter.isBlacklisted) {
+            result.reason = DetectionReason::Blacklisted;
+        }
+        return counter.isBlacklisted; // Return current blacklist status
+    }
+}
+
+void SecurityDetector::updateMessageCounter(int senderId, double now) {
+    auto it = messageCounters.find(senderId);
+
+    if (it == messageCounters.end()) {
+        // First message from this sender
+        MessageCounter& counter = messageCounters[senderId];
+        activeSenders++;
+        setCount(counter, 1);
+        counter.startTime = now;
+        counter.lastHeard = now;
+        counter.messageTimestamps.push_back(now);
+        return;
+    }
+
+    MessageCounter& counter = it->second;
+    counter.lastHeard = now;
+
+    // Check if blacklist period has expired
+    if (counter.isBlacklisted && (now - counter.blacklistTime > params.blacklistTimeout)) {
+        liftBlacklist(counter, now);
+    }
+
+    if (!counter.isBlacklisted) {
+        // Add current timestamp and maintain sliding window
+        counter.messageTimestamps.push_back(now);
+
+        // Remove timestamps outside the detection window
+        double oldThreshold = now - params.detectionWindow;
+        while (!counter.messageTimestamps.empty() &&
+               counter.messageTimestamps.front() < oldThreshold) {
+            counter.messageTimestamps.pop_front();
+        }
+        setCount(counter, int(counter.messageTimestamps.size()));
+
+        // Update start time if window was empty
+        if (counter.messageTimestamps.empty()) {
+            counter.startTime = now;
+        }
+    }
+}
+
+// ==================== ENHANCED DETECTION ALGORITHMS ====================
+
+DetectionResult SecurityDetector::detectMaliciousBehavior(const ReceptionEvent& ev) {
+    DetectionResult result;
+    bool detected = false;
+    int senderId = ev.senderId;
+
+    // ========== ENHANCED FLOOD/DOS DETECTION ==========
+    auto counterIt = messageCounters.find(senderId);
+    if (counterIt != messageCounters.end()) {
+        MessageCounter& counter = counterIt->second;
+        double currentRate = counter.count / params.detectionWindow;
+        result.rate = currentRate;
+
+        // Multi-level flood detection
+        if (currentRate > params.severeFloodThreshold) {
+            detected = true;
+            result.reason = DetectionReason::SevereFlood;
+            setBlacklisted(counter, true);
+            counter.blacklistTime = ev.time;
+        }
+        else if (currentRate > params.floodThreshold) {
+            // Check for burst detection
+            if (detectBurstAttack(counter)) {
+                detected = true;
+                result.reason = DetectionReason::BurstAttack;
+                setBlacklisted(counter, true);
+                counter.blacklistTime = ev.time;
+            }
+            // Check for sustained high rate
+            else if (counter.suspicionStartTime != -1) {
+                double suspicionTime = ev.time - counter.suspicionStartTime;
+                if (suspicionTime > params.persistentFloodDuration) {
+                    detected = true;
+                    result.reason = DetectionReason::SustainedFlood;
+                    result.duration = suspicionTime;
+                    setBlacklisted(counter, true);
+                    counter.blacklistTime = ev.time;
+                }
+            }
+        }
+
+        // Entropy-based anomaly detection
+        if (!detected && params.entropyBasedDetection) {
+            if (detectAnomalousTraffic(senderId, currentRate)) {
+                detected = true;
+                result.reason = DetectionReason::AnomalousTraffic;
+                counter.suspicionLevel++; // Increase suspicion level
+                if (counter.suspicionLevel > params.maxSuspicionLevel) {
+                    setBlacklisted(counter, true);
+                    counter.blacklistTime = ev.time;
+                }
+            }
+        }
+    }
+
+    // ========== MESSAGE CONTENT VALIDATION ==========
+    if (!detected && params.messageValidation) {
+        result.content = validateMessageContent(ev);
+        if (result.content != ContentCheck::Valid) {
+            detected = true;
+            result.reason = DetectionReason::InvalidContent;
+        }
+    }
+
+    if (detected) {
+        result.verdict = DetectionVerdict::Detected;
+    }
+    return result;
+}
+
+bool SecurityDetector::detectBurstAttack(const MessageCounter& counter) const {
+    if (counter.messageTimestamps.size() < (size_t)params.minBurstSize) {
+        return false;
+    }
+
+    // Check for rapid succession of messages (burst)
+    auto recentStart = counter.messageTimestamps.end() - std::min((size_t)params.minBurstSize, counter.messageTimestamps.size());
+    double burstDuration = counter.messageTimestamps.back() - *recentStart;
+
+    if (burstDuration < params.maxBurstDuration) {
+        double burstRate = params.minBurstSize / burstDuration;
+        return burstRate > params.burstThreshold;
+    }
+
+    return false;
+}
+
+bool SecurityDetector::detectAnomalousTraffic(int senderId, double currentRate) const {
+    // Average rate across all senders not blacklisted, for comparison; the
+    // sums are kept up to date by every change to a counter
+    if (activeSenders > 0) {
+        double totalRate = activeMessages / params.detectionWindow;
+        double averageRate = totalRate / activeSenders;
+        double rateDeviation = std::abs(currentRate - averageRate) / averageRate;
+
+        // If rate is significantly higher than network average
+        return rateDeviation > params.anomalyThreshold;
+    }
+
+    return false;
+}
+
+ContentCheck SecurityDetector::validateMessageContent(const ReceptionEvent& ev) const {
+    // Validate position coordinates
+    if (std::isnan(ev.posX) || std::isnan(ev.posY) ||
+        std::isinf(ev.posX) || std::isinf(ev.posY)) {
+        return ContentCheck::InvalidPosition;
+    }
+
+    // Validate speed (reasonable vehicle speeds)
+    double speed = std::sqrt(ev.speedX * ev.speedX + ev.speedY * ev.speedY);
+    if (speed > params.maxReasonableSpeed) {
+        return ContentCheck::UnreasonableSpeed;
+    }
+
+    // Validate timestamp (not from future, not too old)
+    if (ev.timestamp > ev.time) {
+        return ContentCheck::FutureTimestamp;
+    }
+
+    if (ev.time - ev.timestamp > params.maxMessageAge) {
+        return ContentCheck::StaleMessage;
+    }
+
+    return ContentCheck::Valid;
+}
+
+// ==================== MAINTENANCE ====================
+
+void SecurityDetector::setCount(MessageCounter& counter, int count) {
+    if (!counter.isBlacklisted) {
+        activeMessages += count - counter.count;
+    }
+    counter.count = count;
+}
+
+void SecurityDetector::setBlacklisted(MessageCounter& counter, bool blacklisted) {
+    if (counter.isBlacklisted == blacklisted) {
+        return;
+    }
+    counter.isBlacklisted = blacklisted;
+    int sign = blacklisted ? -1 : 1;
+    activeSenders += sign;
+    activeMessages += sign * int64_t(counter.count);
+}
+
+void SecurityDetector::liftBlacklist(MessageCounter& counter, double now) {
+    setBlacklisted(counter, false);
+    setCount(counter, 0);
+    counter.startTime = now;
+    counter.suspicionStartTime = -1;
+    counter.messageTimestamps.clear();
+}
+
+bool SecurityDetector::expireBlacklist(int senderId, double now) {
+    auto it = messageCounters.find(senderId);
+    // Same comparison as the lazy check in updateMessageCounter
+    if (it == messageCounters.end() || !it->second.isBlacklisted
+            || now - it->second.blacklistTime <= params.blacklistTimeout) {
+        return false;
+    }
+    liftBlacklist(it->second, now);
+    return true;
+}
+
+void SecurityDetector::decaySuspicion(int senderId) {
+    auto it = messageCounters.find(senderId);
+    if (it != messageCounters.end() && it->second.suspicionLevel > 0) {
+        it->second.suspicionLevel--;
+    }
+}
+
+bool SecurityDetector::erase(int senderId) {
+    auto it = messageCounters.find(senderId);
+    if (it == messageCounters.end()) {
+        return false;
+    }
+    setBlacklisted(it->second, true);              // Takes it out of the sums
+    messageCounters.erase(it);
+    return true;
+}
+
+void SecurityDetector::clear() {
+    messageCounters.clear();
+    activeSenders = 0;
+    activeMessages = 0;
+}
+
+const MessageCounter* SecurityDetector::findCounter(int senderId) const {
+    auto it = messageCounters.find(senderId);
+    return it == messageCounters.end() ? nullptr : &it->second;
+}
+
+bool SecurityDetector::isBlacklisted(int senderId) const {
+    auto it = messageCounters.find(senderId);
+    return it != messageCounters.end() && it->second.isBlacklisted;
+}
+
+int SecurityDetector::countBlacklisted() const {
+    int blacklisted = 0;
+    for (const auto& entry : messageCounters) {
+        if (entry.second.isBlacklisted) {
+            blacklisted++;
+        }
+    }
+    return blacklisted;
+}
+
+size_t SecurityDetector::memoryFootprint() const {
+    // libstdc++: red-black tree node header of four words, deque chunks of
+    // 512 bytes plus a map of at least eight chunk pointers
+    const size_t treeNodeHeader = 4 * sizeof(void*);
+    const size_t dequeChunk = 512;
+    const size_t timestampsPerChunk = dequeChunk / sizeof(double);
+
+    size_t bytes = sizeof(*this);
+    for (const auto& entry : messageCounters) {
+        size_t chunks = entry.second.messageTimestamps.size() / timestampsPerChunk + 1;
+        bytes += treeNodeHeader + sizeof(entry);
+        bytes += chunks * dequeChunk + std::max<size_t>(8, chunks + 2) * sizeof(double*);
+    }
+    return bytes;
+}
@@ -0,0 +1,152 @@
+#ifndef SECURITYDETECTOR_H
+#define SECURITYDETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <deque>
+
+// The detector core is deliberately free of OMNeT++ dependencies so the exact
+// same code can run inside MyVeinsApp and in the offline tools (trace replay,
+// benchmarks). Times are plain seconds.
+
+namespace veins {
+
+// Detection thresholds and timing, mirrors the MyVeinsApp parameters
+struct DetectorParams {
+    double floodThreshold = 50.0;                  // Basic flood detection threshold
+    double severeFloodThreshold = 100.0;           // Severe flood threshold
+    double burstThreshold = 200.0;                 // Burst attack threshold
+    double anomalyThreshold = 2.0;                 // Anomaly detection threshold
+
+    double detectionWindow = 3.0;                  // Primary detection window (s)
+    double blacklistTimeout = 30.0;                // Blacklist duration (s)
+    double persistentFloodDuration = 6.0;          // Persistent flood duration (s)
+    double maxBurstDuration = 1.0;                 // Maximum burst duration (s)
+    double maxMessageAge = 5.0;                    // Maximum acceptable message age (s)
+
+    int minBurstSize = 50;                         // Minimum messages for burst
+    int maxSuspicionLevel = 3;                     // Maximum suspicion level
+    double maxReasonableSpeed = 50.0;              // Maximum believable speed (m/s)
+
+    bool entropyBasedDetection = true;             // Entropy-based detection
+    bool messageValidation = true;                 // Message content validation
+};
+
+// Everything the detectors look at for one received beacon
+struct ReceptionEvent {
+    int receiverId = -1;                           // Receiving node ID
+    int senderId = -1;                             // Claimed source node ID
+    double time = 0.0;                             // Reception time
+    double posX = 0.0;                             // Claimed position
+    double posY = 0.0;
+    double speedX = 0.0;                           // Claimed speed
+    double speedY = 0.0;
+    double timestamp = 0.0;                        // Claimed send time
+};
+
+// Enhanced message counter with sliding window support
+struct MessageCounter {
+    int count = 0;                                 // Current message count in window
+    double startTime = -1;                         // Start time of current window
+    double suspicionStartTime = -1;                // When suspicion started
+    double blacklistTime = -1;                     // When blacklisted
+    bool isBlacklisted = false;                    // Blacklist status
+    int suspicionLevel = 0;                        // Suspicion level (0-10)
+    double lastHeard = -1;                         // Last message, blacklisted or not
+    std::deque<double> messageTimestamps;          // Sliding window of timestamps
+
+    MessageCounter() = default;
+};
+
+enum class DetectionVerdict {
+    Accepted,                                      // Message may be processed
+    Blocked,                                       // Sender is (now) blacklisted, drop
+    Detected                                       // Message itself flagged as malicious
+};
+
+enum class DetectionReason {
+    None,
+    Blacklisted,                                   // Already on the blacklist
+    SevereFlood,
+    PersistentFlood,
+    BurstAttack,
+    SustainedFlood,
+    AnomalousTraffic,
+    InvalidContent,
+    SybilIdentity                                  // One of several identities of one radio (SybilDetector)
+};
+
+enum class ContentCheck {
+    Valid,
+    InvalidPosition,
+    UnreasonableSpeed,
+    FutureTimestamp,
+    StaleMessage
+};
+
+struct DetectionResult {
+    DetectionVerdict verdict = DetectionVerdict::Accepted;
+    DetectionReason reason = DetectionReason::None;
+    ContentCheck content = ContentCheck::Valid;
+    double rate = 0.0;                             // Sender rate at decision time
+    double duration = 0.0;                         // Suspicion duration, if relevant
+};
+
+const char* detectionReasonName(DetectionReason reason);
+const char* contentCheckName(ContentCheck check);
+
+class SecurityDetector {
+public:
+    explicit SecurityDetector(const DetectorParams& params = DetectorParams());
+
+    const DetectorParams& getParams() const { return params; }
+    void setParams(const DetectorParams& p) { params = p; }
+
+    // Full receive path: blacklist check, counter update, behaviour analysis
+    DetectionResult inspect(const ReceptionEvent& ev);
+
+    // Primary detection methods
+    bool isFloodAttacker(int senderId, double now);
+    bool isFloodAttacker(int senderId, double now, DetectionResult& result);
+    void updateMessageCounter(int senderId, double now);
+    DetectionResult detectMaliciousBehavior(const ReceptionEvent& ev);
+
+    // Advanced detection algorithms
+    bool detectBurstAttack(const MessageCounter& counter) const;
+    bool detectAnomalousTraffic(int senderId, double currentRate) const;
+    ContentCheck validateMessageContent(const ReceptionEvent& ev) const;
+
+    const std::map<int, MessageCounter>& getCounters() const { return messageCounters; }
+    const MessageCounter* findCounter(int senderId) const;
+    bool isBlacklisted(int senderId) const;
+    int countBlacklisted() const;
+
+    // Approximate heap and object bytes held by the detector (map nodes and
+    // timestamp deques, as libstdc++ allocates them)
+    size_t memoryFootprint() const;
+
+    // Maintenance from outside the receive path (MyVeinsApp's timing wheel);
+    // the receive path still lifts an expired blacklist entry lazily
+    bool expireBlacklist(int senderId, double now); // True if the entry was lifted
+    void decaySuspicion(int senderId);             // One level down
+    bool erase(int senderId);                      // Forget an idle sender
+
+    void clear();
+
+private:
+    // Every change of a counter's count or blacklist state goes through
+    // these, keeping the sums detectAnomalousTraffic averages over current
+    void setCount(MessageCounter& counter, int count);
+    void setBlacklisted(MessageCounter& counter, bool blacklisted);
+    void liftBlacklist(MessageCounter& counter, double now);
+
+    DetectorParams params;
+    std::map<int, MessageCounter> messageCounters; // Per-sender counters
+    int activeSenders = 0;                         // Senders not blacklisted
+    int64_t activeMessages = 0;                    // Sum of their counts
+};
+
+} // namespace veins
+
+#endif // SECURITYDETECTOR_H
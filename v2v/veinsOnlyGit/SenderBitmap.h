@@ -0,0 +1,98 @@
+#ifndef SENDERBITMAP_H
+#define SENDERBITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Compact set of sender IDs, one bit per ID. OMNeT++ module IDs are small and
+// dense, so membership is a single shift-and-mask on a contiguous word array.
+// Sender IDs come from the frames, though, and a forged one can be anything:
+// the word array only covers IDs below DenseLimit (8 KB at most), larger IDs
+// go to a sparse overflow set.
+
+namespace veins {
+
+class SenderBitmap {
+public:
+    static constexpr int DenseLimit = 1 << 16;
+
+    bool test(int id) const {
+        if (id >= DenseLimit) {
+            return !overflow.empty() && overflow.count(id) > 0;
+        }
+        size_t word = (size_t)id >> 6;
+        return id >= 0 && word < words.size() && ((words[word] >> (id & 63)) & 1);
+    }
+
+    void set(int id) {
+        if (id < 0) {
+            return;
+        }
+        if (id >= DenseLimit) {
+            overflow.insert(id);
+            return;
+        }
+        size_t word = (size_t)id >> 6;
+        if (word >= words.size()) {
+            words.resize(word + 1, 0);
+        }
+        words[word] |= uint64_t(1) << (id & 63);
+    }
+
+    void reset(int id) {
+        if (id >= DenseLimit) {
+            overflow.erase(id);
+            return;
+        }
+        size_t word = (size_t)id >> 6;
+        if (id >= 0 && word < words.size()) {
+            words[word] &= ~(uint64_t(1) << (id & 63));
+        }
+    }
+
+    int count() const {
+        int bits = 0;
+        for (uint64_t word : words) {
+            bits += __builtin_popcountll(word);
+        }
+        return bits + (int)overflow.size();
+    }
+
+    // Union with another bitmap
+    void merge(const SenderBitmap& other) {
+        if (other.words.size() > words.size()) {
+            words.resize(other.words.size(), 0);
+        }
+        for (size_t i = 0; i < other.words.size(); i++) {
+            words[i] |= other.words[i];
+        }
+        overflow.insert(other.overflow.begin(), other.overflow.end());
+    }
+
+    // Members in ascending order
+    std::vector<int> ids() const {
+        std::vector<int> members;
+        for (size_t w = 0; w < words.size(); w++) {
+            for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                members.push_back(int(w * 64 + __builtin_ctzll(bits)));
+            }
+        }
+        members.insert(members.end(), overflow.begin(), overflow.end());
+        return members;
+    }
+
+    void clear() {
+        words.clear();
+        overflow.clear();
+    }
+
+private:
+    std::vector<uint64_t> words;                   // IDs below DenseLimit
+    std::set<int> overflow;                        // IDs from DenseLimit on
+};
+
+} // namespace veins
+
+#endif // SENDERBITMAP_H
@@ -0,0 +1,142 @@
+#include "veins/modules/application/traci/StageProfiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace veins;
+
+StageProfiler& StageProfiler::instance() {
+    static StageProfiler profiler;
+    return profiler;
+}
+
+StageProfiler::StageProfiler() {
+    stageNames.push_back("run");
+    clear();
+}
+
+int StageProfiler::stage(const char* name) {
+    for (size_t i = 0; i < stageNames.size(); i++) {
+        if (stageNames[i] == name) {
+            return int(i);
+        }
+    }
+    stageNames.push_back(name);
+    return int(stageNames.size()) - 1;
+}
+
+void StageProfiler::enter(int stage) {
+    int parent = stack.empty() ? 0 : stack.back().node;
+    stack.push_back(Frame{child(parent, stage), Clock::now()});
+}
+
+void StageProfiler::leave() {
+    if (stack.empty()) {
+        return;
+    }
+    Frame frame = stack.back();
+    stack.pop_back();
+    uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame.start).count();
+
+    Node& node = nodes[frame.node];
+    node.calls++;
+    node.totalNanos += nanos;
+    int bucket = 0;
+    while (bucket < histogramBuckets - 1 && (nanos >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+    node.histogram[bucket]++;
+    nodes[node.parent].childNanos += nanos;
+}
+
+int StageProfiler::child(int node, int stage) {
+    for (int c : nodes[node].children) {
+        if (nodes[c].stage == stage) {
+            return c;
+        }
+    }
+    Node created;
+    created.stage = stage;
+    created.parent = node;
+    nodes.push_back(created);
+    int index = int(nodes.size()) - 1;
+    nodes[node].children.push_back(index);
+    return index;
+}
+
+std::string StageProfiler::path(int node) const {
+    std::string result = stageNames[nodes[node].stage];
+    for (int p = nodes[node].parent; p >= 0; p = nodes[p].parent) {
+        result = stageNames[nodes[p].stage] + ";" + result;
+    }
+    return result;
+}
+
+uint64_t StageProfiler::selfNanos(int node) const {
+    const Node& n = nodes[node];
+    if (node == 0) {
+        // Everything outside the instrumented stages
+        uint64_t run = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - runStart).count();
+        return run > n.childNanos ? run - n.childNanos : 0;
+    }
+    return n.totalNanos > n.childNanos ? n.totalNanos - n.childNanos : 0;
+}
+
+uint64_t StageProfiler::percentileNanos(const Node& node, double q) const {
+    uint64_t rank = uint64_t(std::ceil(q * node.calls));
+    uint64_t seen = 0;
+    for (int b = 0; b < histogramBuckets; b++) {
+        seen += node.histogram[b];
+        if (seen >= rank && seen > 0) {
+            // Geometric middle of [2^b, 2^(b+1))
+            return uint64_t(std::ldexp(std::sqrt(2.0), b));
+        }
+    }
+    return 0;
+}
+
+bool StageProfiler::writeFolded(const std::string& fileName) const {
+    std::FILE* file = std::fopen(fileName.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    for (size_t i = 0; i < nodes.size(); i++) {
+        uint64_t micros = selfNanos(int(i)) / 1000;
+        if (micros > 0) {
+            std::fprintf(file, "%s %llu\n", path(int(i)).c_str(), (unsigned long long)micros);
+        }
+    }
+    return std::fclose(file) == 0;
+}
+
+bool StageProfiler::writeSummary(const std::string& fileName) const {
+    std::FILE* file = std::fopen(fileName.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    uint64_t run = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - runStart).count();
+    std::fprintf(file, "stage,calls,totalMs,selfMs,selfShare,meanUs,p50Us,p99Us\n");
+    std::fprintf(file, "run,1,%.3f,%.3f,%.4f,,,\n", run / 1e6, selfNanos(0) / 1e6, run ? double(selfNanos(0)) / run : 0.0);
+
+    // Heaviest paths first
+    std::vector<int> order;
+    for (size_t i = 1; i < nodes.size(); i++) {
+        order.push_back(int(i));
+    }
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return nodes[a].totalNanos > nodes[b].totalNanos;
+    });
+    for (int i : order) {
+        const Node& n = nodes[i];
+        std::fprintf(file, "%s,%llu,%.3f,%.3f,%.4f,%.3f,%.3f,%.3f\n", path(i).c_str(), (unsigned long long)n.calls,
+                n.totalNanos / 1e6, selfNanos(i) / 1e6, run ? double(selfNanos(i)) / run : 0.0,
+                n.calls ? n.totalNanos / 1e3 / n.calls : 0.0, percentileNanos(n, 0.5) / 1e3, percentileNanos(n, 0.99) / 1e3);
+    }
+    return std::fclose(file) == 0;
+}
+
+void StageProfiler::clear() {
+    nodes.assign(1, Node());
+    stack.clear();
+    runStart = Clock::now();
+}
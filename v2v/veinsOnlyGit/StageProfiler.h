@@ -0,0 +1,108 @@
+#ifndef STAGEPROFILER_H
+#define STAGEPROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Wall-clock profile of the simulation's hot path, split into named stages.
+// Stages nest at run time (e.g. traciStep;mobilityUpdate;app.position), so
+// the same stage reached from different callers is kept apart. Per call path
+// the profiler keeps the call count, total and self time and a log2 histogram
+// of the call durations. Time not spent in any instrumented stage (the radio,
+// MAC and event scheduling of Veins/INET) is reported as the self time of the
+// root stage "run".
+//
+// The timers are only compiled in with -DV2V_PROFILE_STAGES (for both Veins
+// and veins_inet, see src/makefrag); without it V2V_PROFILE_SCOPE expands to
+// nothing.
+
+namespace veins {
+
+class StageProfiler {
+public:
+    static const int histogramBuckets = 40;        // log2(ns)
+
+    static StageProfiler& instance();
+
+    // Id of a stage name, registered on first use
+    int stage(const char* name);
+
+    // Starts timing stage as a child of the stage currently running; calls
+    // must be strictly nested
+    void enter(int stage);
+    void leave();
+
+    // Folded stacks ("run;a;b <self microseconds>") for flamegraph.pl and
+    // speedscope, and a per-path table with calls, times and percentiles
+    bool writeFolded(const std::string& fileName) const;
+    bool writeSummary(const std::string& fileName) const;
+
+    // Forgets all samples and restarts the run clock
+    void clear();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Node {
+        int stage = 0;
+        int parent = -1;
+        std::vector<int> children;
+        uint64_t calls = 0;
+        uint64_t totalNanos = 0;
+        uint64_t childNanos = 0;
+        uint64_t histogram[histogramBuckets] = {};
+    };
+
+    struct Frame {
+        int node;
+        Clock::time_point start;
+    };
+
+    StageProfiler();
+
+    int child(int node, int stage);
+    std::string path(int node) const;
+    uint64_t selfNanos(int node) const;
+    uint64_t percentileNanos(const Node& node, double q) const;
+
+    std::vector<std::string> stageNames;
+    std::vector<Node> nodes;                       // nodes[0] is "run"
+    std::vector<Frame> stack;
+    Clock::time_point runStart;
+};
+
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(int stage) { StageProfiler::instance().enter(stage); }
+    ~ScopedStageTimer() { StageProfiler::instance().leave(); }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+};
+
+} // namespace veins
+
+#define V2V_PROFILE_CONCAT2(a, b) a##b
+#define V2V_PROFILE_CONCAT(a, b) V2V_PROFILE_CONCAT2(a, b)
+
+#ifdef V2V_PROFILE_STAGES
+// Times the rest of the enclosing block as stage name (a string literal)
+#define V2V_PROFILE_SCOPE(name) \
+    static const int V2V_PROFILE_CONCAT(v2vProfileStage, __LINE__) = ::veins::StageProfiler::instance().stage(name); \
+    ::veins::ScopedStageTimer V2V_PROFILE_CONCAT(v2vProfileTimer, __LINE__)(V2V_PROFILE_CONCAT(v2vProfileStage, __LINE__))
+// For stages that begin and end in different functions (e.g. signal handlers)
+#define V2V_PROFILE_BEGIN(name) \
+    do { \
+        static const int v2vProfileStage = ::veins::StageProfiler::instance().stage(name); \
+        ::veins::StageProfiler::instance().enter(v2vProfileStage); \
+    } while (0)
+#define V2V_PROFILE_END() ::veins::StageProfiler::instance().leave()
+#else
+#define V2V_PROFILE_SCOPE(name) ((void) 0)
+#define V2V_PROFILE_BEGIN(name) ((void) 0)
+#define V2V_PROFILE_END() ((void) 0)
+#endif
+
+#endif // STAGEPROFILER_H
@@ -0,0 +1,263 @@
+#include "veins/modules/application/traci/SybilDetector.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace veins;
+
+namespace {
+
+uint64_t pairKey(int a, int b) {
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return (uint64_t(uint32_t(a)) << 32) | uint32_t(b);
+}
+
+} // namespace
+
+SybilDetector::SybilDetector(const SybilParams& params) {
+    setParams(params);
+}
+
+void SybilDetector::setParams(const SybilParams& p) {
+    if (p.positionRadius <= 0) {
+        throw std::invalid_argument("Sybil position radius must be positive");
+    }
+    if (p.evidenceTimeout <= 0) {
+        throw std::invalid_argument("Sybil evidence timeout must be positive");
+    }
+    params = p;
+    clear();
+}
+
+// ==================== RECEIVE PATH ====================
+
+bool SybilDetector::observe(const ReceptionEvent& ev, double rssi) {
+    if (!std::isfinite(ev.posX) || !std::isfinite(ev.posY)) {
+        return isSybil(ev.senderId);               // Content validation deals with these
+    }
+    if (nextExpiry < 0) {
+        nextExpiry = ev.time + params.evidenceTimeout;
+    } else if (ev.time >= nextExpiry) {
+        expire(ev.time);
+        nextExpiry = ev.time + params.evidenceTimeout;
+    }
+
+    auto inserted = senders.emplace(ev.senderId, Sender());
+    Sender& sender = inserted.first->second;
+    uint64_t cell = cellOf(ev.posX, ev.posY);
+    if (inserted.second) {
+        sender.parent = ev.senderId;
+        sender.cell = cell;
+        grid[cell].push_back(ev.senderId);
+    } else if (sender.cell != cell) {
+        moveToCell(ev.senderId, sender, cell);
+    }
+    sender.time = ev.time;
+    sender.rssi = rssi;
+    sender.posX = ev.posX;
+    sender.posY = ev.posY;
+    sender.beacons++;
+
+    correlate(ev.senderId, sender, ev.time);
+    return isSybil(ev.senderId);
+}
+
+void SybilDetector::correlate(int senderId, const Sender& sender, double now) {
+    int32_t cx = int32_t(sender.cell >> 32);
+    int32_t cy = int32_t(uint32_t(sender.cell));
+    double radius2 = params.positionRadius * params.positionRadius;
+
+    for (int32_t dx = -1; dx <= 1; dx++) {
+        for (int32_t dy = -1; dy <= 1; dy++) {
+            auto it = grid.find((uint64_t(uint32_t(cx + dx)) << 32) | uint32_t(cy + dy));
+            if (it == grid.end()) {
+                continue;
+            }
+            for (int otherId : it->second) {
+                if (otherId == senderId) {
+                    continue;
+                }
+                const Sender& other = senders.find(otherId)->second;
+                if (now - other.time > params.timingTolerance) {
+                    continue;
+                }
+                double ex = sender.posX - other.posX;
+                double ey = sender.posY - other.posY;
+                if (ex * ex + ey * ey > radius2) {
+                    continue;
+                }
+                if (std::isfinite(sender.rssi) && std::isfinite(other.rssi)
+                        && std::fabs(sender.rssi - other.rssi) > params.rssiTolerance) {
+                    continue;
+                }
+
+                // Once per pair of beacons, even if this sender repeats itself
+                Evidence& pair = evidence[pairKey(senderId, otherId)];
+                if (pair.countedTime == other.time) {
+                    continue;
+                }
+                // A streak ends when either sender beaconed without a
+                // coincidence since the last one
+                uint32_t& ownBeacons = senderId < otherId ? pair.beaconsLow : pair.beaconsHigh;
+                uint32_t& otherBeacons = senderId < otherId ? pair.beaconsHigh : pair.beaconsLow;
+                if (pair.count > 0 && (sender.beacons - ownBeacons > 1 || other.beacons - otherBeacons > 1)) {
+                    if (pair.count >= params.minCoincidences) {
+                        links--;                   // The cluster splits at the next rebuild
+                    }
+                    pair.count = 0;
+                }
+                ownBeacons = sender.beacons;
+                otherBeacons = other.beacons;
+                pair.countedTime = other.time;
+                pair.lastTime = now;
+                if (++pair.count == params.minCoincidences) {
+                    links++;
+                    unite(senderId, otherId);
+                }
+            }
+        }
+    }
+}
+
+// ==================== CLUSTERS ====================
+
+int SybilDetector::find(int senderId) const {
+    // Union by size keeps the trees logarithmically shallow without path
+    // compression, so lookups can stay const
+    int root = senderId;
+    for (;;) {
+        int parent = senders.find(root)->second.parent;
+        if (parent == root) {
+            return root;
+        }
+        root = parent;
+    }
+}
+
+void SybilDetector::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return;
+    }
+    Sender& rootA = senders.find(a)->second;
+    Sender& rootB = senders.find(b)->second;
+    if (rootA.size < rootB.size) {
+        rootA.parent = b;
+        rootB.size += rootA.size;
+    } else {
+        rootB.parent = a;
+        rootA.size += rootB.size;
+    }
+}
+
+int SybilDetector::clusterSize(int senderId) const {
+    if (senders.find(senderId) == senders.end()) {
+        return 0;
+    }
+    return senders.find(find(senderId))->second.size;
+}
+
+bool SybilDetector::isSybil(int senderId) const {
+    return clusterSize(senderId) >= params.minClusterSize;
+}
+
+int SybilDetector::countSybil() const {
+    int count = 0;
+    for (const auto& entry : senders) {
+        if (isSybil(entry.first)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// ==================== MAINTENANCE ====================
+
+uint64_t SybilDetector::cellOf(double x, double y) const {
+    int32_t cx = int32_t(std::floor(x / params.positionRadius));
+    int32_t cy = int32_t(std::floor(y / params.positionRadius));
+    return (uint64_t(uint32_t(cx)) << 32) | uint32_t(cy);
+}
+
+void SybilDetector::moveToCell(int senderId, Sender& sender, uint64_t cell) {
+    removeFromCell(senderId, sender.cell);
+    sender.cell = cell;
+    grid[cell].push_back(senderId);
+}
+
+void SybilDetector::removeFromCell(int senderId, uint64_t cell) {
+    auto entry = grid.find(cell);
+    if (entry == grid.end()) {
+        return;
+    }
+    std::vector<int>& members = entry->second;
+    auto it = std::find(members.begin(), members.end(), senderId);
+    if (it != members.end()) {
+        *it = members.back();
+        members.pop_back();
+    }
+    if (members.empty()) {
+        grid.erase(entry);
+    }
+}
+
+void SybilDetector::forget(int senderId) {
+    auto it = senders.find(senderId);
+    if (it == senders.end()) {
+        return;
+    }
+    bool linked = clusterSize(senderId) > 1;
+    removeFromCell(senderId, it->second.cell);
+    senders.erase(it);
+
+    // Evidence of an unlinked sender can wait for the next expiry; a returning
+    // sender starts over its beacon count, which breaks any streak
+    if (linked) {
+        rebuildClusters(nextExpiry - params.evidenceTimeout);   // As of the last expiry
+    }
+}
+
+void SybilDetector::expire(double now) {
+    for (auto it = senders.begin(); it != senders.end();) {
+        if (now - it->second.time > params.evidenceTimeout) {
+            removeFromCell(it->first, it->second.cell);
+            it = senders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    rebuildClusters(now);
+}
+
+void SybilDetector::rebuildClusters(double now) {
+    // Union-find cannot split clusters, rebuild them from the remaining links
+    for (auto& entry : senders) {
+        entry.second.parent = entry.first;
+        entry.second.size = 1;
+    }
+    links = 0;
+    for (auto it = evidence.begin(); it != evidence.end();) {
+        int a = int(uint32_t(it->first >> 32));
+        int b = int(uint32_t(it->first));
+        if (now - it->second.lastTime > params.evidenceTimeout || !senders.count(a) || !senders.count(b)) {
+            it = evidence.erase(it);
+            continue;
+        }
+        if (it->second.count >= params.minCoincidences) {
+            links++;
+            unite(a, b);
+        }
+        ++it;
+    }
+}
+
+void SybilDetector::clear() {
+    senders.clear();
+    grid.clear();
+    evidence.clear();
+    links = 0;
+    nextExpiry = -1;
+}
@@ -0,0 +1,105 @@
+#ifndef SYBILDETECTOR_H
+#define SYBILDETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "veins/modules/application/traci/SecurityDetector.h"
+
+// Identity correlation against Sybil attacks. Beacons a single radio sends
+// under several forged sender IDs arrive back to back, with the same
+// received power, claiming positions close to each other; per-sender rate
+// limits never see more than one beacon per identity.
+//
+// A beacon is correlated with the last beacon of every other sender claiming
+// a position within positionRadius (a spatial grid hash with cells of that
+// size, so only the 3x3 cells around it are scanned) that arrived within
+// timingTolerance with a received power within rssiTolerance. Two senders
+// correlated on minCoincidences consecutive beacons are merged into one
+// cluster (union-find), and every member of a cluster of at least
+// minClusterSize senders is flagged. Work per beacon is proportional to the
+// senders nearby, not to the table size.
+//
+// Coincidences only count while neither sender beacons in between: forged
+// identities share one radio and coincide on every beacon, honest vehicles
+// that happen to beacon in phase drift apart with the sender's beacon jitter.
+// A pair whose streak breaks is unlinked at the next rebuild.
+//
+// Senders idle and pair evidence older than evidenceTimeout are dropped once
+// per evidenceTimeout, rebuilding the clusters from the remaining evidence.
+// Like SecurityDetector, this is free of OMNeT++; times are seconds.
+
+namespace veins {
+
+struct SybilParams {
+    double positionRadius = 50.0;                  // Max claimed distance of correlated senders (m), grid cell size
+    double timingTolerance = 0.005;                // Max reception time difference (s)
+    double rssiTolerance = 1.0;                    // Max received power difference (dB)
+    int minCoincidences = 5;                       // Consecutive correlated beacons to link two senders
+    int minClusterSize = 3;                        // Linked senders to flag them as Sybil identities
+    double evidenceTimeout = 10.0;                 // Idle senders and stale pair evidence expire (s)
+};
+
+class SybilDetector {
+public:
+    explicit SybilDetector(const SybilParams& params = SybilParams());
+
+    const SybilParams& getParams() const { return params; }
+    void setParams(const SybilParams& p);
+
+    // Records a received beacon with its received power (dBm, NaN if
+    // unknown, which skips the power check) and tells whether its sender
+    // now belongs to a Sybil cluster
+    bool observe(const ReceptionEvent& ev, double rssi);
+
+    bool isSybil(int senderId) const;
+    int clusterSize(int senderId) const;           // 0 for an unknown sender
+    int countSybil() const;
+    size_t getSenderCount() const { return senders.size(); }
+    size_t getLinkCount() const { return links; }
+
+    // Drops a sender and its clusters' links to it
+    void forget(int senderId);
+    void clear();
+
+private:
+    struct Sender {
+        double time = 0.0;                         // Last reception
+        double rssi = 0.0;                         // Of the last reception
+        double posX = 0.0;                         // Last claimed position
+        double posY = 0.0;
+        uint64_t cell = 0;
+        uint32_t beacons = 0;                      // Received so far
+        int parent = -1;                           // Union-find, sender ID of the parent
+        int size = 1;                              // Cluster size, valid at roots
+    };
+
+    struct Evidence {
+        int count = 0;
+        double lastTime = 0.0;
+        double countedTime = -1.0;                 // Beacon time that last counted, once per beacon pair
+        uint32_t beaconsLow = 0;                   // Beacons of each sender at the last coincidence, lower ID first
+        uint32_t beaconsHigh = 0;
+    };
+
+    uint64_t cellOf(double x, double y) const;
+    void moveToCell(int senderId, Sender& sender, uint64_t cell);
+    void removeFromCell(int senderId, uint64_t cell);
+    void correlate(int senderId, const Sender& sender, double now);
+    int find(int senderId) const;
+    void unite(int a, int b);
+    void expire(double now);
+    void rebuildClusters(double now);
+
+    SybilParams params;
+    std::unordered_map<int, Sender> senders;
+    std::unordered_map<uint64_t, std::vector<int>> grid;   // Cell -> senders whose last claim lies in it
+    std::unordered_map<uint64_t, Evidence> evidence;       // Sender pair (lower ID high) -> correlation
+    size_t links = 0;                              // Pairs at minCoincidences
+    double nextExpiry = -1;
+};
+
+} // namespace veins
+
+#endif // SYBILDETECTOR_H
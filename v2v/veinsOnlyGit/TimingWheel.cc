@@ -0,0 +1,157 @@
+#include "veins/modules/application/traci/TimingWheel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace veins;
+
+constexpr TimingWheel::TimerId TimingWheel::InvalidTimer;
+
+TimingWheel::TimingWheel(double tickLength)
+    : heads(Levels * Slots, Nil) {
+    setTickLength(tickLength);
+}
+
+void TimingWheel::setTickLength(double length) {
+    if (length <= 0) {
+        throw std::invalid_argument("timing wheel tick length must be positive");
+    }
+    if (active > 0) {
+        throw std::logic_error("cannot change the tick length of a timing wheel with timers");
+    }
+    tickLength = length;
+}
+
+double TimingWheel::ticksAt(double t) const {
+    // Tolerate rounding of times that are exact multiples of the tick; the
+    // error grows with the tick count, so the tolerance does too
+    double ticks = t / tickLength;
+    double nearest = std::round(ticks);
+    return std::fabs(ticks - nearest) <= std::max(1e-9, 1e-12 * nearest) ? nearest : ticks;
+}
+
+uint64_t TimingWheel::tickAt(double t) const {
+    double ticks = std::floor(ticksAt(t));
+    return ticks > 0 ? uint64_t(ticks) : 0;
+}
+
+// ==================== TIMERS ====================
+
+TimingWheel::TimerId TimingWheel::schedule(double when, int key, int kind) {
+    uint32_t index;
+    if (freeList != Nil) {
+        index = freeList;
+        freeList = nodes[index].next;
+    } else {
+        index = uint32_t(nodes.size());
+        nodes.emplace_back();
+    }
+
+    Node& node = nodes[index];
+    double ticks = std::ceil(ticksAt(when));
+    node.expiry = ticks > double(currentTick) ? uint64_t(ticks) : currentTick + 1;
+    node.key = key;
+    node.kind = kind;
+    place(index);
+    active++;
+    return (TimerId(node.generation) << 32) | index;
+}
+
+void TimingWheel::cancel(TimerId id) {
+    if (!isScheduled(id)) {
+        return;
+    }
+    uint32_t index = uint32_t(id);
+    unlink(index);
+    release(index);
+}
+
+bool TimingWheel::isScheduled(TimerId id) const {
+    uint32_t index = uint32_t(id);
+    return id != InvalidTimer && index < nodes.size() && nodes[index].slot >= 0
+           && nodes[index].generation == uint32_t(id >> 32);
+}
+
+void TimingWheel::clear() {
+    // Keep the nodes and their generations, so handles from before the clear
+    // cannot match the timers scheduled after it
+    heads.assign(Levels * Slots, Nil);
+    freeList = Nil;
+    for (uint32_t index = 0; index < nodes.size(); index++) {
+        Node& node = nodes[index];
+        if (node.slot >= 0) {
+            node.slot = -1;
+            node.generation++;
+        }
+        node.next = freeList;
+        freeList = index;
+    }
+    active = 0;
+}
+
+// ==================== SLOTS ====================
+
+void TimingWheel::place(uint32_t index) {
+    Node& node = nodes[index];
+    uint64_t delta = node.expiry - currentTick;
+
+    // Coarsest level whose slots still tell the expiry apart; beyond the last
+    // level, park in its farthest slot and cascade again from there
+    int level = 0;
+    while (level < Levels - 1 && delta >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+        level++;
+    }
+    uint64_t expiry = node.expiry;
+    uint64_t horizon = currentTick + (uint64_t(1) << (SlotBits * Levels)) - 1;
+    if (expiry > horizon) {
+        expiry = horizon;
+    }
+    int slot = level * Slots + int((expiry >> (SlotBits * level)) & SlotMask);
+
+    node.slot = slot;
+    node.prev = Nil;
+    node.next = heads[slot];
+    if (node.next != Nil) {
+        nodes[node.next].prev = index;
+    }
+    heads[slot] = index;
+}
+
+void TimingWheel::unlink(uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != Nil) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.slot] = node.next;
+    }
+    if (node.next != Nil) {
+        nodes[node.next].prev = node.prev;
+    }
+}
+
+void TimingWheel::release(uint32_t index) {
+    Node& node = nodes[index];
+    node.slot = -1;
+    node.generation++;
+    node.next = freeList;
+    freeList = index;
+    active--;
+}
+
+void TimingWheel::cascade() {
+    // Whenever the lower levels wrap, the next slot of the level above is
+    // redistributed over them
+    for (int level = 1; level < Levels; level++) {
+        if (currentTick & ((uint64_t(1) << (SlotBits * level)) - 1)) {
+            return;
+        }
+        int slot = level * Slots + int((currentTick >> (SlotBits * level)) & SlotMask);
+        uint32_t index = heads[slot];
+        heads[slot] = Nil;
+        while (index != Nil) {
+            uint32_t next = nodes[index].next;
+            place(index);
+            index = next;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel for many per-sender timers behind one self
+// message. Level 0 has one slot per tick, each further level 64 times coarser
+// slots; timers far out sit in a coarse slot and cascade down a level when
+// the wheel gets there. Timers are nodes of a pool threaded into per-slot
+// doubly linked lists, so schedule and cancel are O(1) and advancing costs
+// one slot per tick plus the timers due.
+//
+// A timer fires at the first tick at or after its time. Handles carry a
+// generation, so cancelling a timer that has already fired is harmless.
+// Like the detector core, this is free of OMNeT++; times are seconds.
+
+namespace veins {
+
+class TimingWheel {
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId InvalidTimer = ~TimerId(0);
+
+    explicit TimingWheel(double tickLength = 0.1);
+
+    double getTickLength() const { return tickLength; }
+    void setTickLength(double length);             // Only while empty
+
+    // Time of the tick the wheel is at
+    double getTime() const { return currentTick * tickLength; }
+
+    TimerId schedule(double when, int key, int kind);
+    void cancel(TimerId id);
+    bool isScheduled(TimerId id) const;
+
+    size_t size() const { return active; }
+    bool empty() const { return active == 0; }
+
+    // Moves the wheel to now and calls fire(key, kind) for every timer due,
+    // in tick order. fire may schedule and cancel timers.
+    template <typename Fire>
+    void advance(double now, Fire fire) {
+        uint64_t target = tickAt(now);
+        while (currentTick < target) {
+            if (active == 0) {
+                currentTick = target;              // Nothing to cascade or fire on the way
+                break;
+            }
+            currentTick++;
+            cascade();
+            int slot = int(currentTick & SlotMask);
+            while (heads[slot] != Nil) {
+                uint32_t index = heads[slot];
+                unlink(index);
+                Node& node = nodes[index];
+                int key = node.key;
+                int kind = node.kind;
+                release(index);
+                fire(key, kind);
+            }
+        }
+    }
+
+    void clear();
+
+private:
+    static constexpr int SlotBits = 6;
+    static constexpr int Slots = 1 << SlotBits;
+    static constexpr uint64_t SlotMask = Slots - 1;
+    static constexpr int Levels = 4;               // 64^4 ticks, ~19 days at 100 ms
+    static constexpr uint32_t Nil = ~uint32_t(0);
+
+    struct Node {
+        uint64_t expiry = 0;                       // Tick
+        uint32_t prev = Nil;
+        uint32_t next = Nil;                       // Also the free list link
+        uint32_t generation = 0;
+        int32_t slot = -1;                         // Level * Slots + slot, -1 while free
+        int key = 0;
+        int kind = 0;
+    };
+
+    double ticksAt(double t) const;
+    uint64_t tickAt(double t) const;
+    void place(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade();
+
+    double tickLength;
+    uint64_t currentTick = 0;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> heads;                   // Levels * Slots list heads
+    uint32_t freeList = Nil;
+    size_t active = 0;
+};
+
+} // namespace veins
+
+#endif // TIMINGWHEEL_H
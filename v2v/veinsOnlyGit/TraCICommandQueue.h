@@ -0,0 +1,48 @@
+#ifndef TRACICOMMANDQUEUE_H
+#define TRACICOMMANDQUEUE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "veins/modules/mobility/traci/TraCICommandInterface.h"
+
+// Per-vehicle queue of TraCI commands. Every command is a blocking round trip
+// to SUMO, and SUMO only acts on them when it advances anyway, so commands are
+// held until the scenario manager starts the next step and sent then. Within
+// a step the last speed wins, and a command equal to the last one sent is
+// dropped.
+
+namespace veins {
+
+class TraCICommandQueue {
+public:
+    void setSpeed(double speed);                   // Negative: give control back to SUMO
+    void changeRoute(const std::string& roadId, double travelTime);
+
+    bool empty() const { return !speedPending && routeChanges.empty(); }
+
+    // Send what is pending; returns the number of round trips made
+    int flush(TraCICommandInterface::Vehicle* vehicle);
+
+    // Forget what was sent, e.g. when the vehicle is re-bound
+    void clear();
+
+    long getRequested() const { return requested; }
+    long getSent() const { return sent; }
+    long getSaved() const { return requested - sent; }
+
+private:
+    bool speedPending = false;
+    double pendingSpeed = 0;
+    bool speedSent = false;
+    double sentSpeed = 0;
+    std::vector<std::pair<std::string, double>> routeChanges;       // In request order
+    std::vector<std::pair<std::string, double>> sentRouteChanges;   // Last travel time per road
+
+    long requested = 0;
+    long sent = 0;
+};
+
+} // namespace veins
+
+#endif // TRACICOMMANDQUEUE_H
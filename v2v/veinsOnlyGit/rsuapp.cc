@@ -1,9 +1,25 @@
 #include "veins/modules/application/traci/RSUApp.h"
+#include "veins/modules/messages/MisbehaviorReport_m.h"
+#include "veins/modules/messages/RevocationUpdate_m.h"
+#include "veins/modules/messages/BackhaulBatch_m.h"
+#include "veins/modules/messages/MyMsg_m.h"
+#include "veins/modules/messages/EdgeVerdict_m.h"
+#include "veins/modules/messages/ReputationMigration_m.h"
+#include <algorithm>
+#include <chrono>
 
 using namespace veins;
 
 Define_Module(veins::RSUApp);
 
+RSUApp::~RSUApp()
+{
+    cancelAndDelete(revocationTimer);
+    cancelAndDelete(batchTimer);
+    cancelAndDelete(verdictTimer);
+    cancelAndDelete(migrationTimer);
+}
+
 void RSUApp::initialize(int stage)
 {
     DemoBaseApplLayer::initialize(stage);
@@ -13,31 +29,550 @@ void RSUApp::initialize(int stage)
         relayToInternet = par("relayToInternet");
         messagesRelayed = 0;
 
+        backhaulInGate = findGate("backhaulIn");
+        backhaulDatarate = par("backhaulDatarate").doubleValue();
+        backhaulDelay = par("backhaulDelay");
+
+        if (relayToInternet) {
+            backend = getModuleByPath(par("backendModule").stringValue());
+            if (!backend) {
+                throw cRuntimeError("relayToInternet needs a backend module at '%s'", par("backendModule").stringValue());
+            }
+            maxBatchRecords = par("maxBatchRecords");
+            maxBatchBytes = par("maxBatchBytes");
+            maxBatchDelay = par("maxBatchDelay");
+            batchTimer = new cMessage("batchTimer");
+
+            batchRecordsHistogram.setName("relayBatchRecords");
+            compressionRatioHistogram.setName("relayCompressionRatio");
+            relayQueueingDelayHistogram.setName("relayQueueingDelay");
+        }
+
+        edgeDetection = par("edgeDetection");
+        if (edgeDetection) {
+            EdgeParams params;
+            params.floodRate = par("edgeFloodRate");
+            params.window = par("edgeWindow").doubleValue();
+            params.maxSpeed = par("edgeMaxSpeed").doubleValue();
+            params.maxRange = par("edgeMaxRange").doubleValue();
+            params.maxMessageAge = par("edgeMaxMessageAge").doubleValue();
+            params.verdictDuration = par("edgeVerdictDuration").doubleValue();
+            params.idleTimeout = par("edgeIdleTimeout").doubleValue();
+            edgeDetector.setParams(params);
+
+            verdictInterval = par("verdictInterval");
+            verdictTimer = new cMessage("verdictTimer");
+            scheduleAt(simTime() + verdictInterval, verdictTimer);
+        }
+
+        stateMigration = par("stateMigration");
+        if (stateMigration) {
+            if (!edgeDetection) {
+                throw cRuntimeError("stateMigration hands over edge detection state, enable edgeDetection");
+            }
+            migrationInterval = par("migrationInterval");
+            handoverHorizon = par("handoverHorizon").doubleValue();
+            migrationCooldown = par("migrationCooldown");
+            maxMigrationBytes = par("maxMigrationBytes");
+            migrationLatencyHistogram.setName("migrationLatency");
+            migrationSizeHistogram.setName("migrationMessageSize");
+            migrationTimer = new cMessage("migrationTimer");
+            scheduleAt(simTime() + migrationInterval, migrationTimer);
+        }
+
+        cooperativeBlacklist = par("cooperativeBlacklist");
+        voteThreshold = par("voteThreshold");
+        voteWindow = par("voteWindow");
+        revocationTimeout = par("revocationTimeout");
+        revocationInterval = par("revocationInterval");
+        fullListInterval = par("fullListInterval");
+        revocationKey = par("revocationKey").intValue();
+        signatureLength = par("signatureLength");
+
+        if (cooperativeBlacklist) {
+            if (voteThreshold < 1) {
+                throw cRuntimeError("voteThreshold must be at least 1");
+            }
+            lastFullList = simTime();
+            revocationTimer = new cMessage("revocationTimer");
+            scheduleAt(simTime() + revocationInterval, revocationTimer);
+        }
+
         EV << "RSU " << myId << " initialized. Internet address: " << internetAddress << endl;
     }
 }
 
+void RSUApp::finish()
+{
+    if (relayToInternet) {
+        recordScalar("messagesRelayedToInternet", messagesRelayed);
+        recordScalar("relayBatchesSent", batchesSent);
+        recordScalar("relayRawBytes", rawBytesRelayed);
+        recordScalar("relayBackhaulBytes", backhaulBytesSent);
+        recordScalar("relayPendingAtEnd", pendingRecords.size());
+        recordScalar("backhaulUtilization", simTime() > 0 ? backhaulBusyTime / simTime() : 0);
+        recordStatistic(&batchRecordsHistogram);
+        recordStatistic(&compressionRatioHistogram);
+        recordStatistic(&relayQueueingDelayHistogram, "s");
+    }
+
+    if (edgeDetection) {
+        recordScalar("edgeObservations", edgeObservations);
+        recordScalar("edgeFloodFlags", edgeFlags[(int)EdgeReason::Flood]);
+        recordScalar("edgeSpoofFlags", edgeFlags[(int)EdgeReason::Spoof]);
+        recordScalar("edgeReplayFlags", edgeFlags[(int)EdgeReason::Replay]);
+        recordScalar("edgeVerdictsSent", verdictsSent);
+        recordScalar("edgeTablePeak", edgeTablePeak);
+        recordScalar("edgeDetectionTime", edgeDetectionTime, "s");
+    }
+
+    if (stateMigration) {
+        recordScalar("migrationMessagesSent", migrationMessagesSent);
+        recordScalar("migrationSnapshotsSent", snapshotsSent);
+        recordScalar("migrationBytesSent", migrationBytesSent);
+        recordScalar("migrationSnapshotsReceived", snapshotsReceived);
+        recordStatistic(&migrationLatencyHistogram, "s");
+        recordStatistic(&migrationSizeHistogram, "B");
+    }
+
+    if (cooperativeBlacklist) {
+        recordScalar("misbehaviorReportsReceived", reportsReceived);
+        recordScalar("revocationsIssued", revocationsIssued);
+        recordScalar("revocationUpdatesSent", updatesSent);
+        recordScalar("revocationUpdateBytesSent", updateBytesSent);
+        recordScalar("revokedNodesAtEnd", revocations.count());
+    }
+
+    DemoBaseApplLayer::finish();
+}
+
+void RSUApp::handleMessage(cMessage* msg)
+{
+    if (msg->getArrivalGateId() == backhaulInGate) {
+        onReputationMigration(check_and_cast<ReputationMigration*>(msg));
+        delete msg;
+        return;
+    }
+    DemoBaseApplLayer::handleMessage(msg);
+}
+
+void RSUApp::handleSelfMsg(cMessage* msg)
+{
+    if (msg == revocationTimer) {
+        updateRevocations();
+        scheduleAt(simTime() + revocationInterval, revocationTimer);
+    }
+    else if (msg == batchTimer) {
+        flushRelayBatch();
+    }
+    else if (msg == verdictTimer) {
+        sendEdgeVerdicts();
+        scheduleAt(simTime() + verdictInterval, verdictTimer);
+    }
+    else if (msg == migrationTimer) {
+        migrateReputation();
+        scheduleAt(simTime() + migrationInterval, migrationTimer);
+    }
+    else {
+        DemoBaseApplLayer::handleSelfMsg(msg);
+    }
+}
+
 void RSUApp::onBSM(DemoSafetyMessage* bsm)
 {
     EV << "RSU " << myId << " received BSM from a vehicle" << endl;
 
     if (relayToInternet) {
-        EV << "RSU relaying BSM to internet" << endl;
-        relayMessageToInternet();
+        RelayRecord record;
+        record.timestamp = bsm->getCreationTime().dbl();
+        record.posX = bsm->getSenderPos().x;
+        record.posY = bsm->getSenderPos().y;
+        record.speedX = bsm->getSenderSpeed().x;
+        record.speedY = bsm->getSenderSpeed().y;
+        record.frameBytes = bsm->getByteLength();
+        relayMessageToInternet(record);
     }
 }
 
 void RSUApp::onWSM(BaseFrame1609_4* wsm)
 {
+    if (auto report = dynamic_cast<MisbehaviorReport*>(wsm)) {
+        if (cooperativeBlacklist) {
+            onMisbehaviorReport(report);
+        }
+        return;
+    }
+
     EV << "RSU " << myId << " received WSM" << endl;
 
+    MyMsg* myMsg = dynamic_cast<MyMsg*>(wsm);
+    if (edgeDetection && myMsg) {
+        ReceptionEvent ev;
+        ev.receiverId = getParentModule()->getId();
+        ev.senderId = myMsg->getSrcId();
+        ev.time = simTime().dbl();
+        ev.posX = myMsg->getSenderPosX();
+        ev.posY = myMsg->getSenderPosY();
+        ev.speedX = myMsg->getSenderSpeedX();
+        ev.speedY = myMsg->getSenderSpeedY();
+        ev.timestamp = myMsg->getTimestamp().dbl();
+        observeSender(ev);
+    }
+
     if (relayToInternet) {
-        relayMessageToInternet();
+        RelayRecord record;
+        record.frameBytes = wsm->getByteLength();
+        if (myMsg) {
+            record.senderId = myMsg->getSrcId();
+            record.packetId = myMsg->getPacketId();
+            record.timestamp = myMsg->getTimestamp().dbl();
+            record.posX = myMsg->getSenderPosX();
+            record.posY = myMsg->getSenderPosY();
+            record.speedX = myMsg->getSenderSpeedX();
+            record.speedY = myMsg->getSenderSpeedY();
+        }
+        relayMessageToInternet(record);
+    }
+}
+
+// ==================== EDGE DETECTION ====================
+
+void RSUApp::observeSender(const ReceptionEvent& ev)
+{
+    edgeDetector.setAnchor(curPosition.x, curPosition.y);
+
+    auto start = std::chrono::steady_clock::now();
+    bool wasFlagged = edgeDetector.isFlagged(ev.senderId, ev.time);
+    EdgeReason reason = edgeDetector.observe(ev);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    edgeDetectionTime += elapsed.count();
+
+    edgeObservations++;
+    edgeTablePeak = std::max(edgeTablePeak, edgeDetector.size());
+    if (reason != EdgeReason::None && !wasFlagged) {
+        edgeFlags[(int)reason]++;
+        EV_WARN << "RSU " << myId << " edge detection: " << edgeReasonName(reason)
+                << " from " << ev.senderId << endl;
+    }
+}
+
+void RSUApp::sendEdgeVerdicts()
+{
+    double now = simTime().dbl();
+    edgeDetector.evictIdle(now);
+
+    EdgeVerdict* verdict = new EdgeVerdict();
+    populateWSM(verdict);
+    verdict->setRsuId(myId);
+    // Valid until the broadcast after next, so one lost verdict does not open a gap
+    verdict->setValidFor(2 * verdictInterval);
+
+    std::vector<const EdgeDetector::SenderState*> flagged;
+    edgeDetector.forEachFlagged(now, [&flagged](const EdgeDetector::SenderState& state) {
+        flagged.push_back(&state);
+    });
+    verdict->setSuspectsArraySize(flagged.size());
+    verdict->setReasonsArraySize(flagged.size());
+    for (size_t i = 0; i < flagged.size(); i++) {
+        verdict->setSuspects(i, flagged[i]->senderId);
+        verdict->setReasons(i, (uint8_t)flagged[i]->reason);
     }
+    verdict->addByteLength(12 + 5 * flagged.size());
+
+    verdictsSent++;
+    sendDown(verdict);
 }
 
-void RSUApp::relayMessageToInternet()
+// ==================== REPUTATION HANDOVER ====================
+
+void RSUApp::resolveNeighbors()
 {
-    EV << "RSU " << myId << " relaying message to internet at: " << internetAddress << endl;
-    recordScalar("messagesRelayedToInternet", ++messagesRelayed);
+    // Every other RSU in the network, reached over the backhaul
+    for (cModule::SubmoduleIterator it(getSystemModule()); !it.end(); ++it) {
+        cModule* appl = (*it)->getSubmodule("appl");
+        RSUApp* rsu = dynamic_cast<RSUApp*>(appl);
+        if (rsu && rsu != this) {
+            Neighbor neighbor;
+            neighbor.app = rsu;
+            neighbors.push_back(neighbor);
+        }
+    }
+    neighborsResolved = true;
+}
+
+void RSUApp::migrateReputation()
+{
+    if (!neighborsResolved) {
+        resolveNeighbors();
+    }
+    double now = simTime().dbl();
+
+    for (auto it = lastMigrated.begin(); it != lastMigrated.end();) {
+        if (simTime() - it->second >= migrationCooldown) {
+            it = lastMigrated.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for (const EdgeDetector::SenderState& state : edgeDetector.getTable()) {
+        // Only senders currently in our cell
+        if (now - state.lastSeen > migrationInterval.dbl()) {
+            continue;
+        }
+
+        // Which RSU will be closest to where the sender is heading?
+        double px = state.lastPosX + state.lastSpeedX * handoverHorizon;
+        double py = state.lastPosY + state.lastSpeedY * handoverHorizon;
+        double best = (px - curPosition.x) * (px - curPosition.x) + (py - curPosition.y) * (py - curPosition.y);
+        Neighbor* target = nullptr;
+        for (Neighbor& neighbor : neighbors) {
+            const Coord& pos = neighbor.app->getPosition();
+            double d = (px - pos.x) * (px - pos.x) + (py - pos.y) * (py - pos.y);
+            if (d < best) {
+                best = d;
+                target = &neighbor;
+            }
+        }
+        if (!target || lastMigrated.count({state.senderId, target->app})) {
+            continue;
+        }
+        lastMigrated[{state.senderId, target->app}] = simTime();
+
+        std::vector<uint8_t> record;
+        appendReputation(record, edgeDetector.snapshot(state, now), now);
+        if (target->pendingCount > 0 && (int)(target->pending.size() + record.size()) > maxMigrationBytes) {
+            sendMigration(*target);
+        }
+        target->pending.insert(target->pending.end(), record.begin(), record.end());
+        target->pendingCount++;
+    }
+
+    for (Neighbor& neighbor : neighbors) {
+        if (neighbor.pendingCount > 0) {
+            sendMigration(neighbor);
+        }
+    }
+}
+
+void RSUApp::sendMigration(Neighbor& neighbor)
+{
+    ReputationMigration* migration = new ReputationMigration("reputationMigration");
+    migration->setFromRsuId(myId);
+    migration->setSentAt(simTime());
+    migration->setCount(neighbor.pendingCount);
+    migration->setPayloadArraySize(neighbor.pending.size());
+    for (size_t i = 0; i < neighbor.pending.size(); i++) {
+        migration->setPayload(i, neighbor.pending[i]);
+    }
+    // Header plus UDP/IPv4 headers
+    migration->setByteLength(16 + 28 + neighbor.pending.size());
+
+    migrationMessagesSent++;
+    snapshotsSent += neighbor.pendingCount;
+    migrationBytesSent += migration->getByteLength();
+    migrationSizeHistogram.collect(migration->getByteLength());
+
+    EV << "RSU " << myId << " handing over " << neighbor.pendingCount << " senders to "
+       << neighbor.app->getParentModule()->getFullName() << endl;
+    sendOverBackhaul(migration, neighbor.app);
+
+    neighbor.pending.clear();
+    neighbor.pendingCount = 0;
+}
+
+void RSUApp::onReputationMigration(ReputationMigration* migration)
+{
+    std::vector<uint8_t> payload(migration->getPayloadArraySize());
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = migration->getPayload(i);
+    }
+
+    // Times in the payload are relative to when the snapshot was taken
+    std::vector<ReputationSnapshot> snapshots;
+    if (!decodeReputation(payload, migration->getSentAt().dbl(), snapshots)) {
+        EV_WARN << "RSU " << myId << " dropping malformed reputation migration from " << migration->getFromRsuId() << endl;
+        return;
+    }
+    for (const ReputationSnapshot& snapshot : snapshots) {
+        edgeDetector.import(snapshot, simTime().dbl());
+    }
+    snapshotsReceived += snapshots.size();
+    migrationLatencyHistogram.collect(simTime() - migration->getSentAt());
+}
+
+// ==================== BACKEND RELAY ====================
+
+void RSUApp::relayMessageToInternet(const RelayRecord& record)
+{
+    if (pendingRecords.empty()) {
+        scheduleAt(simTime() + maxBatchDelay, batchTimer);
+    }
+    pendingRecords.push_back(record);
+    pendingArrivals.push_back(simTime());
+    pendingRawBytes += record.frameBytes;
+    messagesRelayed++;
+
+    if ((int)pendingRecords.size() >= maxBatchRecords || pendingRawBytes >= maxBatchBytes) {
+        flushRelayBatch();
+    }
+}
+
+void RSUApp::flushRelayBatch()
+{
+    cancelEvent(batchTimer);
+    if (pendingRecords.empty()) {
+        return;
+    }
+
+    std::vector<uint8_t> payload = encodeRelayRecords(pendingRecords);
+
+    BackhaulBatch* batch = new BackhaulBatch("relayBatch");
+    batch->setRsuId(myId);
+    batch->setRecordCount(pendingRecords.size());
+    batch->setRawBytes(pendingRawBytes);
+    batch->setOldestReception(pendingArrivals.front());
+    batch->setPayloadArraySize(payload.size());
+    for (size_t i = 0; i < payload.size(); i++) {
+        batch->setPayload(i, payload[i]);
+    }
+    // Batch header plus UDP/IPv4 headers
+    batch->setByteLength(16 + 28 + payload.size());
+
+    batchesSent++;
+    rawBytesRelayed += pendingRawBytes;
+    backhaulBytesSent += batch->getByteLength();
+    batchRecordsHistogram.collect(pendingRecords.size());
+    compressionRatioHistogram.collect((double)pendingRawBytes / batch->getByteLength());
+
+    EV << "RSU " << myId << " relaying " << pendingRecords.size() << " messages to " << internetAddress
+       << " | " << pendingRawBytes << " -> " << batch->getByteLength() << " bytes" << endl;
+
+    simtime_t start = sendOverBackhaul(batch, backend);
+    for (simtime_t arrival : pendingArrivals) {
+        relayQueueingDelayHistogram.collect(start - arrival);
+    }
+
+    pendingRecords.clear();
+    pendingArrivals.clear();
+    pendingRawBytes = 0;
+}
+
+simtime_t RSUApp::sendOverBackhaul(cPacket* pkt, cModule* target)
+{
+    // Point-to-point link of backhaulDatarate: transmissions queue behind each other
+    simtime_t start = std::max(simTime(), backhaulBusyUntil);
+    simtime_t duration = pkt->getBitLength() / backhaulDatarate;
+    backhaulBusyUntil = start + duration;
+    backhaulBusyTime += duration;
+
+    sendDirect(pkt, start - simTime() + backhaulDelay, duration, target, "backhaulIn");
+    return start;
+}
+
+// ==================== COOPERATIVE BLACKLIST ====================
+
+void RSUApp::onMisbehaviorReport(MisbehaviorReport* report)
+{
+    reportsReceived++;
+    int suspect = report->getSuspectId();
+    if (suspect == report->getReporterId() || revocations.isRevoked(suspect)) {
+        return;
+    }
+
+    std::map<int, simtime_t>& reporters = votes[suspect];
+    reporters[report->getReporterId()] = simTime();
+    forgetStaleVotes(reporters);                   // Before counting
+
+    EV << "RSU " << myId << " misbehaviour report against " << suspect
+       << " from " << report->getReporterId() << " (" << reporters.size() << "/" << voteThreshold << " votes)" << endl;
+
+    if ((int)reporters.size() >= voteThreshold) {
+        revocations.revoke(suspect);
+        revokedAt[suspect] = simTime();
+        votes.erase(suspect);
+        revocationsIssued++;
+        EV_WARN << "RSU " << myId << " REVOKED node " << suspect << endl;
+    }
+}
+
+void RSUApp::forgetStaleVotes(std::map<int, simtime_t>& reporters)
+{
+    for (auto it = reporters.begin(); it != reporters.end();) {
+        if (simTime() - it->second > voteWindow) {
+            it = reporters.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void RSUApp::updateRevocations()
+{
+    // Suspects that never reach the threshold would otherwise stay for good
+    for (auto it = votes.begin(); it != votes.end();) {
+        forgetStaleVotes(it->second);
+        if (it->second.empty()) {
+            it = votes.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Revocations are temporary, like a local blacklisting
+    for (auto it = revokedAt.begin(); it != revokedAt.end();) {
+        if (simTime() - it->second > revocationTimeout) {
+            revocations.restore(it->first);
+            it = revokedAt.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (revocations.hasPendingChanges()) {
+        sendRevocationUpdate(false);
+    }
+    // Periodic full list for vehicles that entered coverage late or missed a delta
+    if (simTime() - lastFullList >= fullListInterval && revocations.getEpoch() > 0) {
+        sendRevocationUpdate(true);
+    }
+}
+
+void RSUApp::sendRevocationUpdate(bool full)
+{
+    uint32_t baseEpoch = revocations.getEpoch();
+    std::vector<uint8_t> payload;
+    if (full) {
+        payload = revocations.encodeFull();
+        lastFullList = simTime();
+    }
+    else {
+        payload = revocations.takeDelta();
+    }
+
+    RevocationUpdate* update = new RevocationUpdate();
+    populateWSM(update);
+    update->setIssuerId(myId);
+    update->setFull(full);
+    update->setBaseEpoch(full ? 0 : baseEpoch);
+    update->setEpoch(revocations.getEpoch());
+    update->setPayloadArraySize(payload.size());
+    for (size_t i = 0; i < payload.size(); i++) {
+        update->setPayload(i, payload[i]);
+    }
+    update->setSignature(revocationDigest(revocationKey, myId, full, update->getBaseEpoch(), update->getEpoch(), payload));
+
+    // Header: issuer, flags, two epochs; plus payload and signature
+    int bytes = 13 + payload.size() + signatureLength;
+    update->addByteLength(bytes);
+    updatesSent++;
+    updateBytesSent += bytes;
+
+    EV << "RSU " << myId << " broadcasting " << (full ? "full revocation list" : "revocation delta")
+       << " epoch " << update->getEpoch() << " | " << revocations.count() << " revoked | " << bytes << " bytes" << endl;
+    sendDown(update);
 }